@@ -19,17 +19,22 @@
 
 #include <memory>
 #include <vector>
-#include <queue>
+#include <array>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
 #include <atomic>
 #include <functional>
 #include <cstdint>
+#include <string>
 
 #include "defstruct.h"
 #include "../src/TrackerManager.hpp"
 #include "../src/TrackerVisualizer.hpp"
+#include "../src/BoundedMpmcQueue.hpp"
+#include "../src/TrackSnapshot.hpp"
+#include "../src/TrackGate.hpp"
+#include "../src/PayloadPool.hpp"
+#include "../src/WakeEvent.hpp"
+#include "../src/RenderMailbox.hpp"
 
 namespace track_project
 {
@@ -43,13 +48,29 @@ namespace track_project
     class ManagementService
     {
     public:
+        // 指令合并统计，累计值
+        struct CoalescingStats
+        {
+            std::uint64_t add_commands = 0;           // 收到的ADD指令数
+            std::uint64_t add_batches = 0;            // 合并后实际批量写入次数
+            std::uint64_t add_updates_grouped = 0;    // 同批次中并入同一航迹的点迹数，免去重复解析航迹ID
+            std::uint64_t draw_commands = 0;          // 收到的DRAW指令数
+            std::uint64_t draw_frames_superseded = 0; // 被更新一帧取代而未绘制的DRAW指令数
+        };
+
         /*****************************************************************************
          * @brief 构造函数
          *
-         * @param track_size 航迹容量上限
+         * @param track_size 初始航迹容量
          * @param point_size 点迹容量上限
+         * @param track_ceiling 航迹容量硬上限，突发时按块扩容直到该值
+         * @param silence_timeout_ms 航迹静默超时（毫秒），超过该时长没有新点迹的航迹被删除；不大于0时不老化（默认）
+         * @param checkpoint_path 检查点文件，非空时启动前从该文件恢复航迹、析构时保存；为空不启用
+         * @param render_fps 渲染帧率，渲染线程按该帧率从已发布的快照绘制；为0不启动渲染线程
          *****************************************************************************/
-        ManagementService(std::uint32_t track_size = 2000, std::uint32_t point_size = 2000);
+        ManagementService(std::uint32_t track_size = 2000, std::uint32_t point_size = 2000,
+                          std::uint32_t track_ceiling = 8000, std::int64_t silence_timeout_ms = 0,
+                          const std::string &checkpoint_path = "", std::uint32_t render_fps = 20);
 
         /*****************************************************************************
          * @brief 析构函数，停止工作线程并清理资源
@@ -63,19 +84,49 @@ namespace track_project
         ManagementService &operator=(ManagementService &&) = delete;
 
         /*****************************************************************************
-         * @brief 航迹生成请求
+         * @brief 航迹生成请求，拷贝入参
          *
          * @param new_track 新航迹结构
          *****************************************************************************/
         void create_track_command(std::vector<std::array<TrackPoint, 4>> &new_track);
 
         /*****************************************************************************
-         * @brief 航迹添加请求
+         * @brief 航迹生成请求，数据移入指令，不拷贝
+         * 调用后入参换成一个回收的空缓冲区，保留其容量，可直接填写下一批
+         *
+         * @param new_track 新航迹结构
+         *****************************************************************************/
+        void create_track_command(std::vector<std::array<TrackPoint, 4>> &&new_track);
+
+        /*****************************************************************************
+         * @brief 航迹生成请求，拷贝到回收的缓冲区，稳态下不申请内存
+         *
+         * @param new_track 新航迹结构
+         *****************************************************************************/
+        void create_track_command(trackmanager::BufferSpan<const std::array<TrackPoint, 4>> new_track);
+
+        /*****************************************************************************
+         * @brief 航迹添加请求，拷贝入参
          *
          * @param updated_track 卡尔曼滤波结果
          *****************************************************************************/
         void add_track_command(std::vector<std::pair<TrackerHeader, TrackPoint>> &updated_track);
 
+        /*****************************************************************************
+         * @brief 航迹添加请求，数据移入指令，不拷贝
+         * 调用后入参换成一个回收的空缓冲区，保留其容量，可直接填写下一批
+         *
+         * @param updated_track 卡尔曼滤波结果
+         *****************************************************************************/
+        void add_track_command(std::vector<std::pair<TrackerHeader, TrackPoint>> &&updated_track);
+
+        /*****************************************************************************
+         * @brief 航迹添加请求，拷贝到回收的缓冲区，稳态下不申请内存
+         *
+         * @param updated_track 卡尔曼滤波结果
+         *****************************************************************************/
+        void add_track_command(trackmanager::BufferSpan<const std::pair<TrackerHeader, TrackPoint>> updated_track);
+
         /*****************************************************************************
          * @brief 航迹融合请求
          *
@@ -85,19 +136,83 @@ namespace track_project
         void merge_command(std::uint32_t source_track_id, std::uint32_t target_track_id);
 
         /*****************************************************************************
-         * @brief 点迹绘制请求
+         * @brief 点迹绘制请求，拷贝入参
          *
          * @param point 请求绘制的点迹
          *****************************************************************************/
         void draw_point_command(std::vector<TrackPoint> &point);
 
+        /*****************************************************************************
+         * @brief 点迹绘制请求，数据移入指令，不拷贝
+         * 调用后入参换成一个回收的空缓冲区，保留其容量，可直接填写下一批
+         *
+         * @param point 请求绘制的点迹
+         *****************************************************************************/
+        void draw_point_command(std::vector<TrackPoint> &&point);
+
+        /*****************************************************************************
+         * @brief 点迹绘制请求，拷贝到回收的缓冲区，稳态下不申请内存
+         *
+         * @param point 请求绘制的点迹
+         *****************************************************************************/
+        void draw_point_command(trackmanager::BufferSpan<const TrackPoint> point);
+
         /*****************************************************************************
          * @brief 清空数据区
          *****************************************************************************/
         void clear_all_command();
 
+        /*****************************************************************************
+         * @brief 取出一条航迹生命周期事件，无锁，可在任意线程调用
+         *
+         * @param event 输出事件
+         * @return bool 队列为空返回false
+         *****************************************************************************/
+        bool poll_track_event(TrackEvent &event) { return event_queue_.try_pop(event); }
+
+        // 因事件队列已满而丢弃的事件数
+        std::uint64_t get_dropped_event_count() const { return event_queue_.dropped(); }
+
+        // 指令合并统计，可在任意线程调用
+        CoalescingStats get_coalescing_stats() const;
+
+        /*****************************************************************************
+         * @brief 暂停指令处理，返回时工作线程已处理完当前一轮并停在循环开头
+         * 暂停期间指令照常入队，恢复后按积压一次处理；某类指令队列写满时提交方等待到恢复
+         * 用于维护（如外部保存检查点前冻结状态）与测试积压场景，不能在工作线程中调用
+         *****************************************************************************/
+        void pause_processing();
+
+        // 恢复指令处理
+        void resume_processing();
+
+        /*****************************************************************************
+         * @brief 开启航迹只读会话，可在任意线程调用，读取不阻塞工作线程
+         * 会话期间读到的航迹头与点迹保证完整一致，读取已删除的航迹返回false
+         *****************************************************************************/
+        trackmanager::TrackerManager::ReadSession read_session() const { return tracker_manager_.read_session(); }
+
+        /*****************************************************************************
+         * @brief 取得最新发布的活跃航迹快照，可在任意线程调用，无等待
+         * 快照含全部活跃航迹的航迹头与各自最新SNAPSHOT_POINTS_PER_TRACK个点迹，持有期间内容不变
+         *****************************************************************************/
+        trackmanager::TrackSnapshotPublisher::Handle acquire_snapshot() const { return snapshot_publisher_.acquire(); }
+
+        /*****************************************************************************
+         * @brief 点迹-航迹批量波门筛选，可在任意线程调用
+         * 按最新发布的快照筛选，不访问工作线程正在修改的航迹管理器，结果反映快照发布时的航迹
+         *
+         * @param gate 调用方持有的波门筛选器，同一筛选器不能被多个线程同时使用
+         * @param plots 待关联点迹
+         * @param gate_radius_m 波门半径（米）
+         * @param candidates 输出：candidates[i] 为 plots[i] 的候选航迹ID，顺序不定
+         *****************************************************************************/
+        void gate_plots(trackmanager::TrackGate &gate, const std::vector<TrackPoint> &plots, double gate_radius_m,
+                        std::vector<std::vector<std::uint32_t>> &candidates) const;
+
         /*****************************************************************************
          * @brief 获取TrackerManager引用（只读）
+         * 注意：工作线程会同时修改其内容，其他线程请使用read_session、acquire_snapshot或gate_plots
          *****************************************************************************/
         const trackmanager::TrackerManager &get_tracker_manager() const { return tracker_manager_; }
 
@@ -109,9 +224,13 @@ namespace track_project
             MERGE,      // 航迹融合指令
             CREATE,     // 航迹创建指令
             ADD,        // 航迹添加指令
-            CLEAR_ALL   // 清空所有指令
+            CLEAR_ALL,  // 清空所有指令
+            NONE        // 空指令，仅作默认值（如环形队列空槽位），不入队、不处理
         };
 
+        // 指令类型数，每种类型一个队列，NONE不计入
+        static constexpr size_t COMMAND_TYPE_COUNT = static_cast<size_t>(CommandType::CLEAR_ALL) + 1;
+
         // 指令结构体
         struct Command
         {
@@ -142,8 +261,8 @@ namespace track_project
                 } add_data;
             };
 
-            // 构造函数
-            Command(CommandType t) : type(t) {}
+            // 构造函数，默认构造为空指令，数据指针置空
+            Command(CommandType t = CommandType::NONE) : type(t), draw_data{nullptr} {}
         };
 
         /*****************************************************************************
@@ -151,6 +270,11 @@ namespace track_project
          *****************************************************************************/
         void worker_thread();
 
+        /*****************************************************************************
+         * @brief 渲染线程函数，按帧率绘制最新快照与点迹，OpenCV只在该线程调用
+         *****************************************************************************/
+        void render_thread();
+
         /*****************************************************************************
          * @brief 处理单个指令
          *
@@ -186,12 +310,33 @@ namespace track_project
         void process_clear_all();
 
         /*****************************************************************************
-         * @brief 处理draw指令
+         * @brief 处理draw指令，点迹经渲染帧信箱交给渲染线程，渲染线程尚未取走的旧帧被取代
          *
-         * @param point_data 点迹数据
+         * @param point_data 点迹数据，调用后换成被取代帧的缓冲区
          *****************************************************************************/
         void process_draw(std::vector<TrackPoint> &point_data);
 
+        /*****************************************************************************
+         * @brief 合并处理待处理的ADD指令
+         * 多个批次按航迹ID稳定排序后拼成一批，同一航迹的点迹相邻且保持提交顺序，一次批量写入
+         *
+         * @return bool 是否处理了任何指令
+         *****************************************************************************/
+        bool coalesce_add_commands();
+
+        /*****************************************************************************
+         * @brief 合并处理待处理的DRAW指令，只绘制最新一帧，旧帧直接丢弃
+         *
+         * @return bool 是否处理了任何指令
+         *****************************************************************************/
+        bool coalesce_draw_commands();
+
+        /*****************************************************************************
+         * @brief 老化扫描，未启用老化或距上次扫描不足AGING_SWEEP_INTERVAL_MS时直接返回
+         * @return size_t 删除的航迹数
+         *****************************************************************************/
+        size_t sweep_silent_tracks();
+
         /*****************************************************************************
          * @brief 处理指定类型的所有指令
          *
@@ -200,25 +345,102 @@ namespace track_project
          *****************************************************************************/
         bool process_commands_by_type(CommandType type);
 
+        /*****************************************************************************
+         * @brief 指令按类型入队并唤醒工作线程，无锁；队列满时让出CPU等待工作线程消费
+         *
+         * @param cmd 指令
+         *****************************************************************************/
+        void enqueue_command(const Command &cmd);
+
+        // 是否有待处理指令，并发下为近似值
+        bool has_pending_commands() const;
+
+        // 指令处理完后归还其数据对象
+        void release_payload(const Command &cmd);
+
     private:
+        // 生命周期事件队列容量
+        static constexpr size_t EVENT_QUEUE_CAPACITY = 4096;
+
+        // 老化扫描周期（毫秒），空闲等待指令时也按该周期醒来
+        static constexpr std::int64_t AGING_SWEEP_INTERVAL_MS = 1000;
+
+        // 快照发布失败后的重试周期（毫秒）
+        static constexpr std::int64_t PUBLISH_RETRY_INTERVAL_MS = 10;
+
+        // 每种指令队列容量
+        static constexpr size_t COMMAND_QUEUE_CAPACITY = 1024;
+
+        // 单次合并的ADD指令数上限，限制单批长度
+        static constexpr size_t ADD_COALESCE_LIMIT = 64;
+
+        // 每种指令数据对象池最多缓存的空闲对象数
+        static constexpr size_t PAYLOAD_POOL_CAPACITY = 64;
+
+        // 快照中每条航迹保留的最新点迹数
+        static constexpr std::uint32_t SNAPSHOT_POINTS_PER_TRACK = 32;
+
+        // 生命周期事件队列，须先于Tracker管理器构造、晚于其析构
+        trackmanager::BoundedMpmcQueue<TrackEvent> event_queue_;
+
         // Tracker管理器
         trackmanager::TrackerManager tracker_manager_;
         trackmanager::TrackerVisualizer track_visualizer_;
 
+        // 活跃航迹快照，工作线程每轮处理后发布
+        trackmanager::TrackSnapshotPublisher snapshot_publisher_;
+        bool publish_pending_ = false; // 有未发布的航迹变化，仅工作线程使用
+
         // 线程控制
         std::thread worker_thread_;
+        std::thread render_thread_;
         std::atomic<bool> stop_flag_;
+        std::atomic<bool> pause_requested_{false}; // 暂停请求
+        std::atomic<bool> worker_paused_{false};   // 工作线程已停在暂停点
+
+        // 渲染线程：帧率；点迹帧与画布清空经同一信箱按处理顺序交给渲染线程
+        std::uint32_t render_fps_;
+        trackmanager::RenderMailbox render_mailbox_;
 
-        // 指令队列
-        std::queue<Command> command_queue_;
-        std::mutex queue_mutex_;
-        std::condition_variable queue_cv_;
+        // 指令队列，按类型分开，类型内先进先出；多生产者单消费者无锁环形队列
+        std::array<std::unique_ptr<trackmanager::BoundedMpmcQueue<Command>>, COMMAND_TYPE_COUNT> command_queues_;
 
-        // 数据存储（用于避免数据在队列中失效）
-        std::vector<std::array<TrackPoint, 4>> create_buffer_;
-        std::vector<std::pair<TrackerHeader, TrackPoint>> add_buffer_;
-        std::vector<TrackPoint> draw_buffer_;  // DRAW指令数据缓冲区
-        std::mutex buffer_mutex_;
+        // 工作线程空闲时休眠在eventfd上，提交方仅在其休眠时唤醒
+        trackmanager::WakeEvent wake_event_;
+
+        // 指令数据对象池，每条指令独占一个数据对象，处理完后归还
+        trackmanager::PayloadPool<std::array<TrackPoint, 4>> create_pool_;
+        trackmanager::PayloadPool<std::pair<TrackerHeader, TrackPoint>> add_pool_;
+        trackmanager::PayloadPool<TrackPoint> draw_pool_;
+
+        // 批量添加时返回的终结航迹ID，仅工作线程使用
+        std::vector<std::uint32_t> terminated_ids_;
+
+        // ADD指令合并，仅工作线程使用，复用内存
+        struct AddEntry
+        {
+            std::uint32_t track_id;
+            std::uint32_t payload; // add_payloads_下标
+            std::uint32_t index;   // 批次内下标
+        };
+        std::vector<std::vector<std::pair<TrackerHeader, TrackPoint>> *> add_payloads_;
+        std::vector<AddEntry> add_order_;
+        std::vector<std::pair<TrackerHeader, TrackPoint>> add_batch_;
+
+        // 指令合并统计，工作线程写入
+        std::atomic<std::uint64_t> stat_add_commands_{0};
+        std::atomic<std::uint64_t> stat_add_batches_{0};
+        std::atomic<std::uint64_t> stat_add_updates_grouped_{0};
+        std::atomic<std::uint64_t> stat_draw_commands_{0};
+        std::atomic<std::uint64_t> stat_draw_frames_superseded_{0};
+
+        // 老化扫描，仅工作线程使用
+        std::int64_t silence_timeout_ms_;
+        std::int64_t last_sweep_ms_ = 0;
+        std::vector<std::uint32_t> expired_ids_;
+
+        // 检查点文件，为空不启用
+        std::string checkpoint_path_;
     };
 
 } // namespace track_project
@@ -126,6 +126,34 @@ namespace track_project
     static_assert(std::is_trivially_copyable_v<TrackPoint>, "TrackPoint 不是平凡的");
     static_assert(std::is_standard_layout_v<TrackPoint>, "TrackPoint 不是内存连续的");
 
+    // 航迹生命周期事件类型
+    enum class TrackEventType : std::uint8_t
+    {
+        CREATED,       // 航迹创建，尚无点迹
+        INITIATED,     // 起始点迹写入完成，携带最新点迹位置
+        STATE_CHANGED, // TrackerHeader::state 变化（0正常，1外推，2终结）
+        MERGED,        // 航迹融合，track_id为存活的源航迹，related_id为被并入的目标航迹
+        DELETED,       // 航迹删除，state为删除前状态
+        CLEARED        // 全部航迹清空
+    };
+
+    /*****************************************************************************
+     * @brief 航迹生命周期事件，定长紧凑结构，用于无锁事件队列
+     * 无位置信息的事件（CREATED、CLEARED）经纬度与时间为0
+     *****************************************************************************/
+    struct TrackEvent
+    {
+        TrackEventType type = TrackEventType::CREATED;
+        std::int8_t state = 0;
+        std::uint32_t track_id = 0;
+        std::uint32_t related_id = 0;
+        double longitude = 0.0;
+        double latitude = 0.0;
+        std::int64_t time_ms = 0;
+    };
+
+    static_assert(std::is_trivially_copyable_v<TrackEvent>, "TrackEvent 不是平凡的");
+
 } // track_project
 
 #endif
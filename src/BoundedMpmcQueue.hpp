@@ -0,0 +1,160 @@
+/*****************************************************************************
+ * @file BoundedMpmcQueue.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 有界多生产者多消费者无锁环形队列（Vyukov算法）
+ * 1、容量向上取整为2的幂，构造时一次性申请，之后不再申请内存
+ * 2、每个单元带序号，生产者与消费者各自只竞争一个位置计数器，无锁、无ABA问题
+ * 3、满时try_push立即返回false；push_or_drop在满时丢弃并计数，适合不允许阻塞发布方的事件流
+ * @version 0.1
+ * @date 2025-12-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _BOUNDED_MPMC_QUEUE_HPP_
+#define _BOUNDED_MPMC_QUEUE_HPP_
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <cassert>
+
+namespace track_project::trackmanager
+{
+
+    template <typename T>
+    class BoundedMpmcQueue
+    {
+        static_assert(std::is_nothrow_copy_assignable_v<T> && std::is_default_constructible_v<T>,
+                      "BoundedMpmcQueue 元素需可默认构造且无异常拷贝");
+
+    public:
+        explicit BoundedMpmcQueue(size_t capacity)
+        {
+            assert(capacity > 0 && "申请了过小的队列！");
+
+            size_t size = 2;
+            while (size < capacity)
+            {
+                size <<= 1;
+            }
+            mask_ = size - 1;
+
+            cells_ = std::make_unique<Cell[]>(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        // 多线程共享，禁止拷贝，移动
+        BoundedMpmcQueue(const BoundedMpmcQueue &) = delete;
+        BoundedMpmcQueue &operator=(const BoundedMpmcQueue &) = delete;
+        BoundedMpmcQueue(BoundedMpmcQueue &&) = delete;
+        BoundedMpmcQueue &operator=(BoundedMpmcQueue &&) = delete;
+
+        ~BoundedMpmcQueue() = default;
+
+        /*****************************************************************************
+         * @brief 入队，队列满时返回false
+         *****************************************************************************/
+        bool try_push(const T &item) noexcept
+        {
+            Cell *cell;
+            size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            while (true)
+            {
+                cell = &cells_[pos & mask_];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return false; // 该单元尚未被消费，队列已满
+                }
+                else
+                {
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->data = item;
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // 入队，队列满时丢弃并计数
+        void push_or_drop(const T &item) noexcept
+        {
+            if (!try_push(item))
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /*****************************************************************************
+         * @brief 出队，队列空时返回false
+         *****************************************************************************/
+        bool try_pop(T &item) noexcept
+        {
+            Cell *cell;
+            size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+            while (true)
+            {
+                cell = &cells_[pos & mask_];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return false; // 该单元尚未写入，队列为空
+                }
+                else
+                {
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            item = cell->data;
+            cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+            return true;
+        }
+
+        // 基本信息，并发下为近似值
+        size_t capacity() const noexcept { return mask_ + 1; }
+        size_t size_approx() const noexcept
+        {
+            size_t enq = enqueue_pos_.load(std::memory_order_relaxed);
+            size_t deq = dequeue_pos_.load(std::memory_order_relaxed);
+            return enq > deq ? enq - deq : 0;
+        }
+        std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+
+        // 生产者与消费者计数器分处不同缓存行，避免伪共享
+        static constexpr size_t CACHE_LINE = 64;
+
+        std::unique_ptr<Cell[]> cells_;
+        size_t mask_;
+        alignas(CACHE_LINE) std::atomic<size_t> enqueue_pos_{0};
+        alignas(CACHE_LINE) std::atomic<size_t> dequeue_pos_{0};
+        alignas(CACHE_LINE) std::atomic<std::uint64_t> dropped_{0};
+    };
+
+} // namespace track_project::trackmanager
+
+#endif // _BOUNDED_MPMC_QUEUE_HPP_
@@ -0,0 +1,105 @@
+/*****************************************************************************
+ * @file EpochDomain.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 基于纪元的延迟释放，供其他线程安全读取航迹（管理器收缩时释放的存储块）
+ * 1、读取方进入时登记当前纪元，离开时注销；每个读取方独占一个缓存行，登记与注销各一次原子操作
+ * 2、写入方先摘除对象（读取方此后无法再找到它），再记下当前纪元并推进纪元，对象挂入待回收列表
+ * 3、所有仍登记的读取方纪元都大于对象的摘除纪元时，对象才可复用；没有读取方时写入方直接复用
+ * 4、读取方与写入方之间没有锁，写入方从不等待读取方
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _EPOCH_DOMAIN_HPP_
+#define _EPOCH_DOMAIN_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace track_project::trackmanager
+{
+
+    class EpochDomain
+    {
+    public:
+        // 同时存在的读取方上限
+        static constexpr int MAX_READERS = 64;
+
+        EpochDomain() = default;
+
+        // 多线程共享，禁止拷贝，移动
+        EpochDomain(const EpochDomain &) = delete;
+        EpochDomain &operator=(const EpochDomain &) = delete;
+        EpochDomain(EpochDomain &&) = delete;
+        EpochDomain &operator=(EpochDomain &&) = delete;
+
+        ~EpochDomain() = default;
+
+        /*****************************************************************************
+         * @brief 读取方进入，登记当前纪元
+         * @return 读取方编号，已满返回-1
+         *****************************************************************************/
+        int enter() noexcept
+        {
+            // 先计数再登记，写入方看到计数为0时可确定此后进入的读取方只能看到摘除后的状态
+            active_readers_.fetch_add(1, std::memory_order_seq_cst);
+            std::uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+            for (int i = 0; i < MAX_READERS; ++i)
+            {
+                std::uint64_t idle = IDLE;
+                if (readers_[i].epoch.compare_exchange_strong(idle, epoch, std::memory_order_seq_cst))
+                    return i;
+            }
+            active_readers_.fetch_sub(1, std::memory_order_seq_cst);
+            return -1;
+        }
+
+        // 读取方离开
+        void leave(int reader) noexcept
+        {
+            if (reader < 0)
+                return;
+            readers_[reader].epoch.store(IDLE, std::memory_order_release);
+            active_readers_.fetch_sub(1, std::memory_order_release);
+        }
+
+        // 写入方：摘除对象后调用，是否存在可能持有该对象的读取方
+        bool has_readers() const noexcept { return active_readers_.load(std::memory_order_seq_cst) != 0; }
+
+        // 写入方：返回对象的摘除纪元并推进纪元，此后进入的读取方纪元均大于返回值
+        std::uint64_t retire() noexcept { return epoch_.fetch_add(1, std::memory_order_seq_cst); }
+
+        // 写入方：摘除纪元小于该值的对象可以复用，没有读取方时返回UINT64_MAX
+        std::uint64_t safe_epoch() const noexcept
+        {
+            std::uint64_t min_epoch = UINT64_MAX;
+            if (!has_readers())
+                return min_epoch;
+            for (const auto &reader : readers_)
+            {
+                std::uint64_t epoch = reader.epoch.load(std::memory_order_seq_cst);
+                if (epoch != IDLE && epoch < min_epoch)
+                    min_epoch = epoch;
+            }
+            return min_epoch;
+        }
+
+    private:
+        static constexpr std::uint64_t IDLE = 0; // 纪元从1开始，0表示空闲
+
+        struct alignas(64) Reader
+        {
+            std::atomic<std::uint64_t> epoch{IDLE};
+        };
+
+        alignas(64) std::atomic<std::uint64_t> epoch_{1};
+        alignas(64) std::atomic<std::uint32_t> active_readers_{0};
+        Reader readers_[MAX_READERS];
+    };
+
+} // namespace track_project::trackmanager
+
+#endif // _EPOCH_DOMAIN_HPP_
@@ -6,6 +6,7 @@
  * 2、仅允许追加写入新x数据和定点修改数据，禁止移除数据
  * 3、支持状态管理shutdown()和restart()，支持DEBUG中使用'<<'输出该容器的状态
  * 4、目前设计为禁止拷贝，移动容器
+ * 5、Layout参数默认为AoS，TrackPoint的SoA列存储特化见LatestKBufferSoA.hpp
  * @version 0.1
  * @date 2025-10-25
  *
@@ -20,21 +21,150 @@
 #include <cassert>
 #include <iostream>
 #include <cstring>
+#include <type_traits>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
 
 namespace track_project::trackmanager
 {
+    // 存储布局标签：AoS为结构体数组（默认），SoA为按字段分列存储（仅对特化类型可用）
+    struct AoSLayout
+    {
+    };
+    struct SoALayout
+    {
+    };
 
+    /*****************************************************************************
+     * @brief 连续内存只读视图（C++17下的简易span），不持有数据
+     *****************************************************************************/
     template <typename T>
+    class BufferSpan
+    {
+    public:
+        constexpr BufferSpan() noexcept : data_(nullptr), size_(0) {}
+        constexpr BufferSpan(T *data, size_t size) noexcept : data_(data), size_(size) {}
+
+        constexpr T *data() const noexcept { return data_; }
+        constexpr size_t size() const noexcept { return size_; }
+        constexpr bool empty() const noexcept { return size_ == 0; }
+
+        constexpr T *begin() const noexcept { return data_; }
+        constexpr T *end() const noexcept { return data_ + size_; }
+
+        constexpr T &operator[](size_t index) const noexcept { return data_[index]; }
+
+    private:
+        T *data_;
+        size_t size_;
+    };
+
+    template <typename T, typename Layout = AoSLayout>
     class LatestKBuffer
     {
+        static_assert(std::is_same_v<Layout, AoSLayout>, "SoA布局需要显式特化，见LatestKBufferSoA.hpp");
 
     public:
+        /*****************************************************************************
+         * @brief 逻辑内容的两段连续视图：先遍历first，再遍历second
+         *****************************************************************************/
+        struct Segments
+        {
+            BufferSpan<const T> first;
+            BufferSpan<const T> second;
+        };
+
+        /*****************************************************************************
+         * @brief 按逻辑顺序的只读随机访问迭代器，兼容STL算法
+         *****************************************************************************/
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T *;
+            using reference = const T &;
+
+            const_iterator() noexcept : owner_(nullptr), index_(0) {}
+            const_iterator(const LatestKBuffer *owner, size_t index) noexcept : owner_(owner), index_(index) {}
+
+            reference operator*() const noexcept { return (*owner_)[index_]; }
+            pointer operator->() const noexcept { return &(*owner_)[index_]; }
+            reference operator[](difference_type n) const noexcept { return (*owner_)[index_ + n]; }
+
+            const_iterator &operator++() noexcept
+            {
+                ++index_;
+                return *this;
+            }
+            const_iterator operator++(int) noexcept
+            {
+                const_iterator tmp = *this;
+                ++index_;
+                return tmp;
+            }
+            const_iterator &operator--() noexcept
+            {
+                --index_;
+                return *this;
+            }
+            const_iterator operator--(int) noexcept
+            {
+                const_iterator tmp = *this;
+                --index_;
+                return tmp;
+            }
+            const_iterator &operator+=(difference_type n) noexcept
+            {
+                index_ += n;
+                return *this;
+            }
+            const_iterator &operator-=(difference_type n) noexcept
+            {
+                index_ -= n;
+                return *this;
+            }
+
+            friend const_iterator operator+(const_iterator it, difference_type n) noexcept { return it += n; }
+            friend const_iterator operator+(difference_type n, const_iterator it) noexcept { return it += n; }
+            friend const_iterator operator-(const_iterator it, difference_type n) noexcept { return it -= n; }
+            friend difference_type operator-(const const_iterator &a, const const_iterator &b) noexcept
+            {
+                return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+            }
+
+            friend bool operator==(const const_iterator &a, const const_iterator &b) noexcept { return a.index_ == b.index_; }
+            friend bool operator!=(const const_iterator &a, const const_iterator &b) noexcept { return a.index_ != b.index_; }
+            friend bool operator<(const const_iterator &a, const const_iterator &b) noexcept { return a.index_ < b.index_; }
+            friend bool operator>(const const_iterator &a, const const_iterator &b) noexcept { return a.index_ > b.index_; }
+            friend bool operator<=(const const_iterator &a, const const_iterator &b) noexcept { return a.index_ <= b.index_; }
+            friend bool operator>=(const const_iterator &a, const const_iterator &b) noexcept { return a.index_ >= b.index_; }
+
+        private:
+            const LatestKBuffer *owner_;
+            size_t index_;
+        };
+
         // 构造函数
         explicit LatestKBuffer(size_t capacity)
             : capacity_(capacity), head_(0), tail_(0), size_(0), full_(false)
         {
             assert(capacity_ > 0 && "申请了过小的内存！");
-            buffer_ = std::make_unique<T[]>(capacity_); // 在构造函数体内初始化
+            storage_ = std::make_unique<T[]>(capacity_); // 在构造函数体内初始化
+            buffer_ = storage_.get();
+        }
+
+        // 未绑定存储的空缓冲区，使用前需要 rebind
+        LatestKBuffer() noexcept : capacity_(0), head_(0), tail_(0), size_(0), full_(false) {}
+
+        // 外部存储构造：不持有内存，storage 至少容纳 capacity 个元素且生命周期长于本对象
+        LatestKBuffer(T *storage, size_t capacity)
+            : buffer_(storage), capacity_(capacity), head_(0), tail_(0), size_(0), full_(false)
+        {
+            assert(capacity_ > 0 && "申请了过小的内存！");
+            assert(buffer_ != nullptr && "外部存储为空！");
         }
 
         // 禁止构造、赋值、拷贝，LatestKBuffer 是唯一的，拥有单独的ID号码
@@ -58,6 +188,36 @@ namespace track_project::trackmanager
             full_ = false;
         }
 
+        /*****************************************************************************
+         * @brief 外部存储管理，用于分级存储池中的扩容搬迁
+         *****************************************************************************/
+        // 更换存储：当前内容按逻辑顺序搬到新存储起始处，新容量不得小于当前数据量
+        void rebind(T *storage, size_t capacity) noexcept
+        {
+            assert(storage != nullptr && capacity >= size_ && capacity > 0 && "更换的存储过小！");
+
+            copy_to(storage, size_);
+            storage_.reset();
+
+            buffer_ = storage;
+            capacity_ = capacity;
+            tail_ = 0;
+            head_ = size_ % capacity_;
+            full_ = (size_ == capacity_);
+        }
+
+        // 解除外部存储并清空，返回原存储首地址供归还
+        T *detach() noexcept
+        {
+            assert(!storage_ && "自有存储不可解除！");
+
+            T *storage = buffer_;
+            buffer_ = nullptr;
+            capacity_ = 0;
+            clear();
+            return storage;
+        }
+
         /*****************************************************************************
          * @brief 数据追加写入部分实现
          * 实现了追加写入功能，确保数据一定在结尾追加
@@ -84,6 +244,32 @@ namespace track_project::trackmanager
             _advance_head();
         }
 
+        // 4. 批量写入，最多分两段拷贝；count超过容量时只保留最后capacity_个
+        void push_n(const T *items, size_t count) noexcept
+        {
+            if (!items || count == 0)
+                return;
+
+            if (count >= capacity_)
+            {
+                _memcpy(&buffer_[0], items + (count - capacity_), capacity_);
+                head_ = 0;
+                tail_ = 0;
+                size_ = capacity_;
+                full_ = true;
+                return;
+            }
+
+            size_t firstChunk = std::min(count, capacity_ - head_);
+            _memcpy(&buffer_[head_], items, firstChunk);
+            _memcpy(&buffer_[0], items + firstChunk, count - firstChunk);
+
+            head_ = (head_ + count) % capacity_;
+            size_ = std::min(size_ + count, capacity_);
+            full_ = (size_ == capacity_);
+            tail_ = (head_ + capacity_ - size_) % capacity_;
+        }
+
         /*****************************************************************************
          * @brief 基础参数访问/修改功能
          *****************************************************************************/
@@ -123,7 +309,22 @@ namespace track_project::trackmanager
             return actualCount;
         }
 
+        /*****************************************************************************
+         * @brief 零拷贝只读视图：逻辑内容最多分为两段连续内存
+         *****************************************************************************/
+        Segments segments() const noexcept
+        {
+            size_t firstChunk = std::min(size_, capacity_ - tail_);
+            return Segments{BufferSpan<const T>(&buffer_[tail_], firstChunk),
+                            BufferSpan<const T>(&buffer_[0], size_ - firstChunk)};
+        }
+
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator end() const noexcept { return const_iterator(this, size_); }
+
         // 基本信息
+        T *storage() const noexcept { return buffer_; }
+        const T *write_position() const noexcept { return buffer_ + head_; } // 下一次写入位置，供预取
         size_t capacity() const noexcept { return capacity_; }
         size_t size() const noexcept { return size_; }
         bool empty() const noexcept { return size_ == 0; }
@@ -156,7 +357,8 @@ namespace track_project::trackmanager
         }
 
     private:
-        std::unique_ptr<T[]> buffer_; // data区域，内存格式为连续的数组
+        std::unique_ptr<T[]> storage_; // 自有存储，使用外部存储时为空
+        T *buffer_ = nullptr;          // data区域，内存格式为连续的数组
         size_t capacity_;             // 作为计数器不对外输出结果，不适合使用u32或u64
         size_t head_;
         size_t tail_;
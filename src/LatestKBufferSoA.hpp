@@ -0,0 +1,275 @@
+/*****************************************************************************
+ * @file LatestKBufferSoA.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 滚动更新缓冲区的列存储特化 LatestKBuffer<TrackPoint, SoALayout>
+ * 1、经度、纬度、航速、航向、时间戳、关联标志分别存放在独立数组中，共享同一组环形索引
+ * 2、各列在一次申请的内存块中按缓存行对齐依次排列，元素不做默认构造（Timestamp默认构造会读取系统时钟）
+ * 3、push/operator[]/copy_to 语义与 AoS 版本一致，operator[] 返回值而非引用
+ * 4、提供按列只读访问接口，只读经纬度的扫描不再携带其他字段进入缓存，便于向量化
+ * @version 0.1
+ * @date 2025-12-08
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _LATEST_K_BUFFER_SOA_HPP_
+#define _LATEST_K_BUFFER_SOA_HPP_
+
+#include "LatestKBuffer.hpp"
+#include "../include/defstruct.h"
+
+#include <new>
+
+namespace track_project::trackmanager
+{
+
+    template <>
+    class LatestKBuffer<track_project::TrackPoint, SoALayout>
+    {
+        using TrackPoint = track_project::TrackPoint;
+        using Timestamp = track_project::Timestamp;
+
+    public:
+        /*****************************************************************************
+         * @brief 环形区间描述，逻辑顺序上先是 [first_offset, first_offset + first_count)，
+         * 然后是 [0, second_count)，对所有列通用
+         *****************************************************************************/
+        struct RingSegments
+        {
+            size_t first_offset;
+            size_t first_count;
+            size_t second_count;
+        };
+
+        /*****************************************************************************
+         * @brief 可写代理，用于支持 buffer[i] = point 的定点修改写法
+         *****************************************************************************/
+        class Reference
+        {
+        public:
+            Reference(LatestKBuffer &owner, size_t pos) noexcept : owner_(owner), pos_(pos) {}
+
+            Reference &operator=(const TrackPoint &point) noexcept
+            {
+                owner_._store(pos_, point);
+                return *this;
+            }
+
+            Reference &operator=(const Reference &other) noexcept
+            {
+                owner_._store(pos_, other.owner_._load(other.pos_));
+                return *this;
+            }
+
+            operator TrackPoint() const noexcept { return owner_._load(pos_); }
+
+        private:
+            LatestKBuffer &owner_;
+            size_t pos_;
+        };
+
+        // 列起始地址的对齐字节数
+        static constexpr size_t COLUMN_ALIGNMENT = 64;
+
+        // 构造函数：一次申请全部列，只有写入过的位置才会被读取
+        explicit LatestKBuffer(size_t capacity)
+            : capacity_(capacity), head_(0), tail_(0), size_(0), full_(false)
+        {
+            assert(capacity_ > 0 && "申请了过小的内存！");
+            const size_t double_bytes = _column_bytes(capacity_ * sizeof(double));
+            const size_t time_bytes = _column_bytes(capacity_ * sizeof(Timestamp));
+            const size_t bytes = 4 * double_bytes + time_bytes + _column_bytes(capacity_ * sizeof(bool));
+            block_.reset(static_cast<unsigned char *>(::operator new(bytes, std::align_val_t(COLUMN_ALIGNMENT))));
+
+            unsigned char *column = block_.get();
+            longitude_ = reinterpret_cast<double *>(column);
+            latitude_ = reinterpret_cast<double *>(column += double_bytes);
+            sog_ = reinterpret_cast<double *>(column += double_bytes);
+            cog_ = reinterpret_cast<double *>(column += double_bytes);
+            time_ = reinterpret_cast<Timestamp *>(column += double_bytes);
+            is_associated_ = reinterpret_cast<bool *>(column += time_bytes);
+        }
+
+        // 禁止拷贝，允许移动
+        LatestKBuffer(const LatestKBuffer &) = delete;
+        LatestKBuffer &operator=(const LatestKBuffer &) = delete;
+        LatestKBuffer(LatestKBuffer &&other) = default;
+        LatestKBuffer &operator=(LatestKBuffer &&other) = default;
+
+        ~LatestKBuffer() = default;
+
+        /*****************************************************************************
+         * @brief 数据清空
+         *****************************************************************************/
+        void clear() noexcept
+        {
+            head_ = 0;
+            tail_ = 0;
+            size_ = 0;
+            full_ = false;
+        }
+
+        /*****************************************************************************
+         * @brief 数据追加写入
+         *****************************************************************************/
+        void push(const TrackPoint &item) noexcept
+        {
+            _store(head_, item);
+            _advance_head();
+        }
+
+        template <typename... Args>
+        void emplace(Args &&...args) noexcept
+        {
+            push(TrackPoint{std::forward<Args>(args)...});
+        }
+
+        /*****************************************************************************
+         * @brief 基础参数访问/修改功能，列存储无法返回结构体引用，写入通过代理完成
+         *****************************************************************************/
+        Reference operator[](size_t index) noexcept
+        {
+            return Reference(*this, (tail_ + index) % capacity_);
+        }
+
+        TrackPoint operator[](size_t index) const noexcept
+        {
+            return _load((tail_ + index) % capacity_);
+        }
+
+        // 批量拷贝到目标数组，按结构体重新组装
+        size_t copy_to(TrackPoint *dest, size_t maxCount) const noexcept
+        {
+            if (!dest || maxCount == 0 || empty())
+                return 0;
+
+            size_t actualCount = std::min(size_, maxCount);
+            for (size_t i = 0; i < actualCount; ++i)
+            {
+                dest[i] = _load((tail_ + i) % capacity_);
+            }
+            return actualCount;
+        }
+
+        // 仅拷贝经纬度两列，两段memcpy完成
+        size_t copy_positions_to(double *lon_dest, double *lat_dest, size_t maxCount) const noexcept
+        {
+            if (!lon_dest || !lat_dest || maxCount == 0 || empty())
+                return 0;
+
+            size_t actualCount = std::min(size_, maxCount);
+            size_t firstChunk = std::min(actualCount, capacity_ - tail_);
+
+            std::memcpy(lon_dest, longitude_ + tail_, firstChunk * sizeof(double));
+            std::memcpy(lat_dest, latitude_ + tail_, firstChunk * sizeof(double));
+            std::memcpy(lon_dest + firstChunk, longitude_, (actualCount - firstChunk) * sizeof(double));
+            std::memcpy(lat_dest + firstChunk, latitude_, (actualCount - firstChunk) * sizeof(double));
+
+            return actualCount;
+        }
+
+        /*****************************************************************************
+         * @brief 列访问：返回物理数组首地址，配合 segments() 按逻辑顺序遍历
+         *****************************************************************************/
+        RingSegments segments() const noexcept
+        {
+            size_t firstChunk = std::min(size_, capacity_ - tail_);
+            return RingSegments{tail_, firstChunk, size_ - firstChunk};
+        }
+
+        const double *longitudes() const noexcept { return longitude_; }
+        const double *latitudes() const noexcept { return latitude_; }
+        const double *sogs() const noexcept { return sog_; }
+        const double *cogs() const noexcept { return cog_; }
+        const bool *associations() const noexcept { return is_associated_; }
+        const Timestamp *times() const noexcept { return time_; }
+
+        // 基本信息
+        size_t capacity() const noexcept { return capacity_; }
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        bool full() const noexcept { return full_; }
+
+        /*****************************************************************************
+         * @brief DEBUG用，仅输出状态，不输出数据
+         *****************************************************************************/
+        friend std::ostream &operator<<(std::ostream &os, const LatestKBuffer &buffer)
+        {
+            os << "LatestKBuffer<SoA> [";
+            os << "capacity=" << buffer.capacity_ << ", ";
+            os << "size=" << buffer.size_ << ", ";
+            os << "head=" << buffer.head_ << ", ";
+            os << "tail=" << buffer.tail_ << ", ";
+            os << "full=" << std::boolalpha << buffer.full_ << ", ";
+            os << "]";
+            return os;
+        }
+
+    private:
+        // 按对齐方式归还列内存块
+        struct BlockDeleter
+        {
+            void operator()(unsigned char *block) const noexcept { ::operator delete(block, std::align_val_t(COLUMN_ALIGNMENT)); }
+        };
+
+        // 各列在同一内存块中依次存放，共享同一组环形索引；移动时块与列指针一起转移
+        std::unique_ptr<unsigned char, BlockDeleter> block_;
+        double *longitude_ = nullptr;
+        double *latitude_ = nullptr;
+        double *sog_ = nullptr;
+        double *cog_ = nullptr;
+        Timestamp *time_ = nullptr;
+        bool *is_associated_ = nullptr;
+
+        size_t capacity_;
+        size_t head_;
+        size_t tail_;
+        size_t size_;
+        bool full_;
+
+        // 列长度按对齐字节数取整，保证下一列起始地址对齐
+        static constexpr size_t _column_bytes(size_t bytes) noexcept
+        {
+            return (bytes + COLUMN_ALIGNMENT - 1) & ~(COLUMN_ALIGNMENT - 1);
+        }
+
+        // 拆分写入物理位置，时间戳按拷贝构造放入未构造的内存
+        void _store(size_t pos, const TrackPoint &item) noexcept
+        {
+            longitude_[pos] = item.longitude;
+            latitude_[pos] = item.latitude;
+            sog_[pos] = item.sog;
+            cog_[pos] = item.cog;
+            is_associated_[pos] = item.is_associated;
+            new (&time_[pos]) Timestamp(item.time);
+        }
+
+        // 组装物理位置上的点迹，聚合初始化避免 Timestamp 默认构造读取系统时钟
+        TrackPoint _load(size_t pos) const noexcept
+        {
+            return TrackPoint{longitude_[pos], latitude_[pos], sog_[pos], cog_[pos],
+                              is_associated_[pos], time_[pos]};
+        }
+
+        // 数据写入位置控制，与AoS版本一致
+        void _advance_head() noexcept
+        {
+            if (full_)
+            {
+                tail_ = (tail_ + 1) % capacity_;
+            }
+            else
+            {
+                ++size_;
+            }
+
+            head_ = (head_ + 1) % capacity_;
+            full_ = (head_ == tail_);
+        }
+    };
+
+    // 列存储航迹点缓冲区
+    using TrackPointColumns = LatestKBuffer<track_project::TrackPoint, SoALayout>;
+
+} // namespace track_project::trackmanager
+#endif // _LATEST_K_BUFFER_SOA_HPP_
@@ -17,6 +17,7 @@
 #include "../include/ManagementService.hpp"
 #include <iostream>
 #include <algorithm>
+#include <cassert>
 
 #include "../utils/Logger.hpp"
 
@@ -26,17 +27,61 @@ namespace track_project
     /*****************************************************************************
      * @brief 构造函数
      *
-     * @param track_size 航迹容量上限
+     * @param track_size 初始航迹容量
      * @param point_size 点迹容量上限
+     * @param track_ceiling 航迹容量硬上限
+     * @param silence_timeout_ms 航迹静默超时（毫秒），不大于0时不老化
+     * @param checkpoint_path 检查点文件
+     * @param render_fps 渲染帧率，为0不启动渲染线程
      *****************************************************************************/
-    ManagementService::ManagementService(std::uint32_t track_size, std::uint32_t point_size)
-        : tracker_manager_(track_size, point_size),
+    ManagementService::ManagementService(std::uint32_t track_size, std::uint32_t point_size, std::uint32_t track_ceiling,
+                                         std::int64_t silence_timeout_ms, const std::string &checkpoint_path,
+                                         std::uint32_t render_fps)
+        : event_queue_(EVENT_QUEUE_CAPACITY),
+          tracker_manager_(track_size, point_size, false, track_ceiling),
           track_visualizer_(119.9, 120.1, 29.9, 30.1, track_size, point_size),
-          stop_flag_(false)
+          snapshot_publisher_(SNAPSHOT_POINTS_PER_TRACK),
+          stop_flag_(false),
+          render_fps_(render_fps),
+          create_pool_(PAYLOAD_POOL_CAPACITY),
+          add_pool_(PAYLOAD_POOL_CAPACITY),
+          draw_pool_(PAYLOAD_POOL_CAPACITY),
+          silence_timeout_ms_(silence_timeout_ms),
+          checkpoint_path_(checkpoint_path)
     {
+        // 每种指令一个无锁队列
+        for (auto &queue : command_queues_)
+        {
+            queue = std::make_unique<trackmanager::BoundedMpmcQueue<Command>>(COMMAND_QUEUE_CAPACITY);
+        }
+        if (!wake_event_.valid())
+        {
+            LOG_ERROR << "ManagementService: eventfd创建失败，工作线程空闲时改为轮询";
+        }
+
+        // 航迹管理器发布生命周期事件
+        tracker_manager_.set_event_queue(&event_queue_);
+        tracker_manager_.set_aging_enabled(silence_timeout_ms_ > 0);
+
+        // 工作线程启动前恢复上次保存的航迹，文件不存在时从空白开始
+        if (!checkpoint_path_.empty() && !tracker_manager_.load_checkpoint(checkpoint_path_))
+        {
+            LOG_INFO << "ManagementService: 未从检查点恢复航迹，从空白状态启动";
+        }
+
+        // 发布初始快照，恢复出的航迹在第一条指令到达前即可读取
+        snapshot_publisher_.publish(tracker_manager_, Timestamp::now().milliseconds);
+
         // 启动工作线程
         worker_thread_ = std::thread(&ManagementService::worker_thread, this);
         std::cout << "ManagementService: 工作线程已启动" << std::endl;
+
+        // 启动渲染线程
+        if (render_fps_ > 0)
+        {
+            render_thread_ = std::thread(&ManagementService::render_thread, this);
+            LOG_INFO << "ManagementService: 渲染线程已启动，帧率: " << render_fps_;
+        }
     }
 
     /*****************************************************************************
@@ -47,11 +92,8 @@ namespace track_project
         // 设置停止标志
         stop_flag_ = true;
 
-        // 通知工作线程
-        {
-            std::lock_guard<std::mutex> lock(queue_mutex_);
-            queue_cv_.notify_all();
-        }
+        // 唤醒工作线程
+        wake_event_.notify();
 
         // 等待工作线程结束
         if (worker_thread_.joinable())
@@ -59,64 +101,109 @@ namespace track_project
             worker_thread_.join();
             std::cout << "ManagementService: 工作线程已停止" << std::endl;
         }
+        if (render_thread_.joinable())
+        {
+            render_thread_.join();
+            LOG_INFO << "ManagementService: 渲染线程已停止";
+        }
 
-        // 清理缓冲区
+        // 工作线程已停止，保存检查点供下次启动恢复
+        if (!checkpoint_path_.empty())
         {
-            std::lock_guard<std::mutex> lock(buffer_mutex_);
-            create_buffer_.clear();
-            add_buffer_.clear();
-            draw_buffer_.clear();
+            tracker_manager_.save_checkpoint(checkpoint_path_);
+        }
+
+        // 归还未处理指令的数据对象
+        Command cmd;
+        for (auto &queue : command_queues_)
+        {
+            while (queue->try_pop(cmd))
+            {
+                release_payload(cmd);
+            }
         }
     }
 
     /*****************************************************************************
-     * @brief 航迹生成请求
+     * @brief 航迹生成请求，拷贝入参
      *
      * @param new_track 新航迹结构
      *****************************************************************************/
     void ManagementService::create_track_command(std::vector<std::array<TrackPoint, 4>> &new_track)
     {
-        std::lock_guard<std::mutex> lock(buffer_mutex_);
+        create_track_command(trackmanager::BufferSpan<const std::array<TrackPoint, 4>>(new_track.data(), new_track.size()));
+    }
 
-        // 复制数据到缓冲区
-        create_buffer_ = new_track;
+    /*****************************************************************************
+     * @brief 航迹生成请求，数据移入指令
+     *
+     * @param new_track 新航迹结构，调用后换成回收的空缓冲区
+     *****************************************************************************/
+    void ManagementService::create_track_command(std::vector<std::array<TrackPoint, 4>> &&new_track)
+    {
+        // 与回收对象交换，调用方拿回其容量
+        auto *payload = create_pool_.acquire();
+        payload->swap(new_track);
 
-        // 创建指令并加入队列
         Command cmd(CommandType::CREATE);
-        cmd.create_data.new_track = &create_buffer_;
+        cmd.create_data.new_track = payload;
+        enqueue_command(cmd);
+    }
 
-        {
-            std::lock_guard<std::mutex> queue_lock(queue_mutex_);
-            command_queue_.push(cmd);
-            queue_cv_.notify_one();
-        }
+    /*****************************************************************************
+     * @brief 航迹生成请求，拷贝到回收的缓冲区
+     *
+     * @param new_track 新航迹结构
+     *****************************************************************************/
+    void ManagementService::create_track_command(trackmanager::BufferSpan<const std::array<TrackPoint, 4>> new_track)
+    {
+        auto *payload = create_pool_.acquire();
+        payload->assign(new_track.begin(), new_track.end());
 
-        std::cout << "ManagementService: 创建航迹指令已加入队列，数量: " << new_track.size() << std::endl;
+        Command cmd(CommandType::CREATE);
+        cmd.create_data.new_track = payload;
+        enqueue_command(cmd);
     }
 
     /*****************************************************************************
-     * @brief 航迹添加请求
+     * @brief 航迹添加请求，拷贝入参
      *
      * @param updated_track 卡尔曼滤波结果
      *****************************************************************************/
     void ManagementService::add_track_command(std::vector<std::pair<TrackerHeader, TrackPoint>> &updated_track)
     {
-        std::lock_guard<std::mutex> lock(buffer_mutex_);
+        add_track_command(trackmanager::BufferSpan<const std::pair<TrackerHeader, TrackPoint>>(updated_track.data(), updated_track.size()));
+    }
 
-        // 复制数据到缓冲区
-        add_buffer_ = updated_track;
+    /*****************************************************************************
+     * @brief 航迹添加请求，数据移入指令
+     *
+     * @param updated_track 卡尔曼滤波结果，调用后换成回收的空缓冲区
+     *****************************************************************************/
+    void ManagementService::add_track_command(std::vector<std::pair<TrackerHeader, TrackPoint>> &&updated_track)
+    {
+        // 与回收对象交换，调用方拿回其容量
+        auto *payload = add_pool_.acquire();
+        payload->swap(updated_track);
 
-        // 创建指令并加入队列
         Command cmd(CommandType::ADD);
-        cmd.add_data.updated_track = &add_buffer_;
+        cmd.add_data.updated_track = payload;
+        enqueue_command(cmd);
+    }
 
-        {
-            std::lock_guard<std::mutex> queue_lock(queue_mutex_);
-            command_queue_.push(cmd);
-            queue_cv_.notify_one();
-        }
+    /*****************************************************************************
+     * @brief 航迹添加请求，拷贝到回收的缓冲区
+     *
+     * @param updated_track 卡尔曼滤波结果
+     *****************************************************************************/
+    void ManagementService::add_track_command(trackmanager::BufferSpan<const std::pair<TrackerHeader, TrackPoint>> updated_track)
+    {
+        auto *payload = add_pool_.acquire();
+        payload->assign(updated_track.begin(), updated_track.end());
 
-        std::cout << "ManagementService: 添加航迹指令已加入队列，数量: " << updated_track.size() << std::endl;
+        Command cmd(CommandType::ADD);
+        cmd.add_data.updated_track = payload;
+        enqueue_command(cmd);
     }
 
     /*****************************************************************************
@@ -132,14 +219,7 @@ namespace track_project
         cmd.merge_data.source_track_id = source_track_id;
         cmd.merge_data.target_track_id = target_track_id;
 
-        {
-            std::lock_guard<std::mutex> lock(queue_mutex_);
-            command_queue_.push(cmd);
-            queue_cv_.notify_one();
-        }
-
-        std::cout << "ManagementService: 融合航迹指令已加入队列，源ID: "
-                  << source_track_id << ", 目标ID: " << target_track_id << std::endl;
+        enqueue_command(cmd);
     }
 
     /*****************************************************************************
@@ -150,13 +230,7 @@ namespace track_project
         // 创建指令并加入队列
         Command cmd(CommandType::CLEAR_ALL);
 
-        {
-            std::lock_guard<std::mutex> lock(queue_mutex_);
-            command_queue_.push(cmd);
-            queue_cv_.notify_one();
-        }
-
-        std::cout << "ManagementService: 清空所有指令已加入队列" << std::endl;
+        enqueue_command(cmd);
     }
 
     /*****************************************************************************
@@ -172,45 +246,131 @@ namespace track_project
 
         while (!stop_flag_)
         {
-            // 按照优先级顺序处理指令
+            // 暂停：登记已暂停后休眠，直到恢复或停止
+            if (pause_requested_.load(std::memory_order_acquire))
+            {
+                worker_paused_.store(true, std::memory_order_release);
+                while (pause_requested_.load(std::memory_order_acquire) && !stop_flag_)
+                {
+                    wake_event_.prepare_wait();
+                    if (!pause_requested_.load(std::memory_order_acquire) || stop_flag_)
+                        wake_event_.cancel_wait();
+                    else
+                        wake_event_.wait_for(static_cast<int>(AGING_SWEEP_INTERVAL_MS));
+                }
+                worker_paused_.store(false, std::memory_order_release);
+                continue;
+            }
+
+            // 按照优先级顺序处理指令；changed只记录修改航迹的指令，DRAW不改变航迹
             bool processed = false;
+            bool changed = false;
 
-            // 处理所有DRAW指令（优先级最高）
-            processed |= process_commands_by_type(CommandType::DRAW);
+            // 处理所有DRAW指令（优先级最高），只绘制最新一帧
+            processed |= coalesce_draw_commands();
 
             // 处理所有MERGE指令
-            processed |= process_commands_by_type(CommandType::MERGE);
+            changed |= process_commands_by_type(CommandType::MERGE);
 
             // 处理所有CREATE指令
-            processed |= process_commands_by_type(CommandType::CREATE);
+            changed |= process_commands_by_type(CommandType::CREATE);
 
-            // 处理所有ADD指令
-            processed |= process_commands_by_type(CommandType::ADD);
+            // 处理所有ADD指令，合并成批量写入
+            changed |= coalesce_add_commands();
 
             // 处理CLEAR_ALL指令（如果有）
-            processed |= process_commands_by_type(CommandType::CLEAR_ALL);
+            changed |= process_commands_by_type(CommandType::CLEAR_ALL);
 
-            // 绘制航迹（显示当前状态）
-            track_visualizer_.draw_track(tracker_manager_);
+            // 删除长时间没有新点迹的航迹
+            changed |= sweep_silent_tracks() > 0;
+            processed |= changed;
 
-            // 如果没有指令处理，等待新指令
-            if (!processed && !stop_flag_)
+            // 有航迹变化时发布新快照，只拷贝变化的航迹；备用缓冲区均被读取方持有时发布失败，
+            // 保留待发布标记，之后每轮（包括空闲唤醒）重试，直到成功
+            publish_pending_ |= changed;
+            if (publish_pending_)
             {
-                std::unique_lock<std::mutex> lock(queue_mutex_);
-                queue_cv_.wait(lock, [this]()
-                               { return !command_queue_.empty() || stop_flag_; });
+                publish_pending_ = !snapshot_publisher_.publish(tracker_manager_, Timestamp::now().milliseconds);
             }
 
-            // 短暂休眠避免CPU空转
+            // 释放收缩时因只读会话保留的存储块
+            tracker_manager_.reclaim_chunks();
+
+            // 如果没有指令处理，登记休眠后再检查一次，仍无指令才休眠，最多一个老化扫描周期；有待发布快照时按重试周期醒来
             if (!processed && !stop_flag_)
             {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                wake_event_.prepare_wait();
+                if (has_pending_commands() || stop_flag_)
+                {
+                    wake_event_.cancel_wait();
+                }
+                else
+                {
+                    wake_event_.wait_for(static_cast<int>(publish_pending_ ? PUBLISH_RETRY_INTERVAL_MS : AGING_SWEEP_INTERVAL_MS));
+                }
             }
         }
 
         std::cout << "ManagementService: 工作线程结束运行" << std::endl;
     }
 
+    /*****************************************************************************
+     * @brief 渲染线程函数，按帧率绘制
+     *
+     * 每帧依次执行：最新渲染帧（清空代数变化时先清空画布，再绘制点迹） -> 最新快照；绘制耗时超过帧间隔时顺延，不补帧
+     *****************************************************************************/
+    void ManagementService::render_thread()
+    {
+        const auto frame_interval = std::chrono::nanoseconds(1000000000LL / render_fps_);
+        auto next_frame = std::chrono::steady_clock::now();
+
+        while (!stop_flag_)
+        {
+            // 取走最新渲染帧：清空代数变化时先清空画布，再绘制该帧点迹
+            render_mailbox_.take([this]()
+                                 { track_visualizer_.clear_all(); },
+                                 [this](const std::vector<TrackPoint> &points)
+                                 { track_visualizer_.draw_point_cloud(points); });
+
+            {
+                auto snapshot = snapshot_publisher_.acquire();
+                track_visualizer_.draw_snapshot(*snapshot);
+            }
+
+            next_frame += frame_interval;
+            auto now = std::chrono::steady_clock::now();
+            if (next_frame < now)
+            {
+                next_frame = now;
+            }
+            else
+            {
+                std::this_thread::sleep_until(next_frame);
+            }
+        }
+    }
+
+    /*****************************************************************************
+     * @brief 老化扫描，按墙上时间推进航迹管理器的时间轮
+     *****************************************************************************/
+    size_t ManagementService::sweep_silent_tracks()
+    {
+        if (silence_timeout_ms_ <= 0)
+            return 0;
+
+        std::int64_t now_ms = Timestamp::now().milliseconds;
+        if (now_ms - last_sweep_ms_ < AGING_SWEEP_INTERVAL_MS)
+            return 0;
+        last_sweep_ms_ = now_ms;
+
+        size_t expired = tracker_manager_.expire_silent_tracks(now_ms, silence_timeout_ms_, expired_ids_);
+        if (expired > 0)
+        {
+            LOG_INFO << "ManagementService: 删除静默超时航迹" << expired << "条";
+        }
+        return expired;
+    }
+
     /*****************************************************************************
      * @brief 处理指定类型的所有指令
      *
@@ -221,52 +381,121 @@ namespace track_project
     {
         bool processed = false;
 
+        trackmanager::BoundedMpmcQueue<Command> &queue = *command_queues_[static_cast<size_t>(type)];
+
         while (!stop_flag_)
         {
-            Command cmd(type); // 默认值，实际类型会被检查
+            // 取出该类型最早的一条指令
+            Command cmd(type);
+            if (!queue.try_pop(cmd))
+            {
+                break; // 没有该类型的指令
+            }
+            processed = true;
 
-            // 检查队列中是否有指定类型的指令
+            // 处理找到的指令
+            try
             {
-                std::lock_guard<std::mutex> lock(queue_mutex_);
+                process_command(cmd);
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "ManagementService: 处理指令时发生异常: " << e.what() << std::endl;
+            }
+            release_payload(cmd);
+        }
 
-                // 查找第一个指定类型的指令
-                std::queue<Command> temp_queue;
-                bool found = false;
+        return processed;
+    }
 
-                while (!command_queue_.empty())
-                {
-                    Command current_cmd = command_queue_.front();
-                    command_queue_.pop();
-
-                    if (!found && current_cmd.type == type)
-                    {
-                        cmd = current_cmd;
-                        found = true;
-                        processed = true;
-                    }
-                    else
-                    {
-                        temp_queue.push(current_cmd);
-                    }
-                }
+    /*****************************************************************************
+     * @brief 指令按类型入队并唤醒工作线程
+     *
+     * @param cmd 指令
+     *****************************************************************************/
+    void ManagementService::enqueue_command(const Command &cmd)
+    {
+        assert(cmd.type != CommandType::NONE && "空指令不能入队！");
+        trackmanager::BoundedMpmcQueue<Command> &queue = *command_queues_[static_cast<size_t>(cmd.type)];
 
-                // 将其他指令放回队列
-                while (!temp_queue.empty())
-                {
-                    command_queue_.push(temp_queue.front());
-                    temp_queue.pop();
-                }
+        // 队列满时唤醒工作线程并让出CPU，指令不丢弃；服务停止后不再入队
+        while (!queue.try_push(cmd))
+        {
+            if (stop_flag_)
+            {
+                release_payload(cmd);
+                return;
+            }
+            wake_event_.notify();
+            std::this_thread::yield();
+        }
+        wake_event_.notify();
+    }
 
-                if (!found)
+    /*****************************************************************************
+     * @brief 合并处理待处理的ADD指令
+     *
+     * @return bool 是否处理了任何指令
+     *****************************************************************************/
+    bool ManagementService::coalesce_add_commands()
+    {
+        trackmanager::BoundedMpmcQueue<Command> &queue = *command_queues_[static_cast<size_t>(CommandType::ADD)];
+        bool processed = false;
+
+        while (!stop_flag_)
+        {
+            // 1.取出待处理的ADD指令
+            size_t popped = 0;
+            Command cmd;
+            add_payloads_.clear();
+            while (popped < ADD_COALESCE_LIMIT && queue.try_pop(cmd))
+            {
+                popped++;
+                if (cmd.add_data.updated_track != nullptr)
+                    add_payloads_.push_back(cmd.add_data.updated_track);
+            }
+            if (popped == 0)
+            {
+                break;
+            }
+            processed = true;
+
+            // 2.按航迹ID稳定排序，同一航迹的点迹保持提交顺序
+            add_order_.clear();
+            for (std::uint32_t p = 0; p < add_payloads_.size(); ++p)
+            {
+                const auto &payload = *add_payloads_[p];
+                for (std::uint32_t i = 0; i < payload.size(); ++i)
                 {
-                    break; // 没有找到指定类型的指令
+                    add_order_.push_back({payload[i].first.track_id, p, i});
                 }
             }
+            std::stable_sort(add_order_.begin(), add_order_.end(), [](const AddEntry &a, const AddEntry &b)
+                             { return a.track_id < b.track_id; });
 
-            // 处理找到的指令
+            // 3.拼成一批，数据对象随即归还
+            size_t grouped = 0;
+            add_batch_.clear();
+            for (size_t k = 0; k < add_order_.size(); ++k)
+            {
+                const AddEntry &entry = add_order_[k];
+                if (k > 0 && add_order_[k - 1].track_id == entry.track_id)
+                    grouped++;
+                add_batch_.push_back((*add_payloads_[entry.payload])[entry.index]);
+            }
+            for (auto *payload : add_payloads_)
+            {
+                add_pool_.release(payload);
+            }
+
+            stat_add_commands_.fetch_add(popped, std::memory_order_relaxed);
+            stat_add_batches_.fetch_add(1, std::memory_order_relaxed);
+            stat_add_updates_grouped_.fetch_add(grouped, std::memory_order_relaxed);
+
+            // 4.一次批量写入
             try
             {
-                process_command(cmd);
+                process_add(add_batch_);
             }
             catch (const std::exception &e)
             {
@@ -277,6 +506,108 @@ namespace track_project
         return processed;
     }
 
+    /*****************************************************************************
+     * @brief 合并处理待处理的DRAW指令
+     *
+     * @return bool 是否处理了任何指令
+     *****************************************************************************/
+    bool ManagementService::coalesce_draw_commands()
+    {
+        trackmanager::BoundedMpmcQueue<Command> &queue = *command_queues_[static_cast<size_t>(CommandType::DRAW)];
+
+        // 每帧重置背景，只有最新一帧可见，旧帧直接归还
+        Command latest;
+        Command cmd;
+        size_t popped = 0;
+        while (queue.try_pop(cmd))
+        {
+            if (popped > 0)
+                release_payload(latest);
+            latest = cmd;
+            popped++;
+        }
+        if (popped == 0)
+        {
+            return false;
+        }
+
+        stat_draw_commands_.fetch_add(popped, std::memory_order_relaxed);
+        stat_draw_frames_superseded_.fetch_add(popped - 1, std::memory_order_relaxed);
+
+        try
+        {
+            process_command(latest);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "ManagementService: 处理指令时发生异常: " << e.what() << std::endl;
+        }
+        release_payload(latest);
+        return true;
+    }
+
+    void ManagementService::pause_processing()
+    {
+        pause_requested_.store(true, std::memory_order_release);
+        wake_event_.notify();
+        while (!worker_paused_.load(std::memory_order_acquire) && !stop_flag_)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void ManagementService::resume_processing()
+    {
+        pause_requested_.store(false, std::memory_order_release);
+        wake_event_.notify();
+    }
+
+    void ManagementService::gate_plots(trackmanager::TrackGate &gate, const std::vector<TrackPoint> &plots, double gate_radius_m,
+                                       std::vector<std::vector<std::uint32_t>> &candidates) const
+    {
+        auto snapshot = snapshot_publisher_.acquire();
+        gate.gate(*snapshot, plots, gate_radius_m, candidates);
+    }
+
+    ManagementService::CoalescingStats ManagementService::get_coalescing_stats() const
+    {
+        CoalescingStats stats;
+        stats.add_commands = stat_add_commands_.load(std::memory_order_relaxed);
+        stats.add_batches = stat_add_batches_.load(std::memory_order_relaxed);
+        stats.add_updates_grouped = stat_add_updates_grouped_.load(std::memory_order_relaxed);
+        stats.draw_commands = stat_draw_commands_.load(std::memory_order_relaxed);
+        stats.draw_frames_superseded = stat_draw_frames_superseded_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void ManagementService::release_payload(const Command &cmd)
+    {
+        switch (cmd.type)
+        {
+        case CommandType::DRAW:
+            draw_pool_.release(cmd.draw_data.point_data);
+            break;
+        case CommandType::CREATE:
+            create_pool_.release(cmd.create_data.new_track);
+            break;
+        case CommandType::ADD:
+            add_pool_.release(cmd.add_data.updated_track);
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool ManagementService::has_pending_commands() const
+    {
+        for (const auto &queue : command_queues_)
+        {
+            if (queue->size_approx() > 0)
+                return true;
+        }
+        return false;
+    }
+
     /*****************************************************************************
      * @brief 处理单个指令
      *
@@ -315,6 +646,9 @@ namespace track_project
             process_clear_all();
             break;
 
+        case CommandType::NONE:
+            break;
+
         default:
             std::cerr << "ManagementService: 未知指令类型" << std::endl;
             break;
@@ -357,10 +691,13 @@ namespace track_project
 
             if (track_id == 0)
             {
-                LOG_ERROR << "ManagementService: 创建航迹 " << track_id << " 失败:航迹已满" << std::endl;
+                LOG_ERROR << "ManagementService: 创建航迹失败:航迹数已达上限"
+                          << tracker_manager_.get_capacity_ceiling() << std::endl;
+                continue;
             }
 
             // 将点迹添加到航迹中
+            bool initiated = true;
             for (const auto &point : track_array)
             {
                 bool push_success = tracker_manager_.push_track_point(track_id, point);
@@ -368,13 +705,27 @@ namespace track_project
                 if (!push_success) // 添加失败撤回整个流程
                 {
                     LOG_ERROR << "ManagementService: 创建航迹 " << track_id << " 失败:unknown" << std::endl;
-                    // 如果添加失败，删除该航迹
+                    // 如果添加失败，删除该航迹，继续处理下一条
                     tracker_manager_.delete_track(track_id);
-                    return;
+                    initiated = false;
+                    break;
                 }
             }
 
-            // TODO，向其他线程发送最新一个航迹点
+            // 向其他线程发送最新一个航迹点
+            if (initiated)
+            {
+                const TrackerHeader *header = tracker_manager_.get_header_ref(track_id);
+                const TrackPoint &latest = track_array.back();
+                TrackEvent event;
+                event.type = TrackEventType::INITIATED;
+                event.state = static_cast<std::int8_t>(header->state);
+                event.track_id = track_id;
+                event.longitude = latest.longitude;
+                event.latitude = latest.latitude;
+                event.time_ms = latest.time.milliseconds;
+                event_queue_.push_or_drop(event);
+            }
         }
     }
 
@@ -387,18 +738,12 @@ namespace track_project
     {
         LOG_DEBUG << "ManagementService: 处理添加指令，更新数量: " << updated_track.size() << std::endl;
 
-        for (auto &pair : updated_track)
-        {
-            TrackerHeader &header = pair.first;
-            TrackPoint &point = pair.second;
-
-            // 添加点迹到航迹
-            bool success = tracker_manager_.push_track_point(header.track_id, point);
+        // 批量添加点迹到航迹
+        tracker_manager_.push_track_points(updated_track, terminated_ids_);
 
-            if (!success)
-            {
-                LOG_ERROR << "ManagementService: 添加点迹到航迹 " << header.track_id << " 失败:unknown" << std::endl;
-            }
+        for (std::uint32_t track_id : terminated_ids_)
+        {
+            LOG_ERROR << "ManagementService: 添加点迹到航迹 " << track_id << " 失败:航迹已终结或不存在" << std::endl;
         }
     }
 
@@ -409,32 +754,54 @@ namespace track_project
     {
         LOG_INFO << "ManagementService: 全部清空";
         tracker_manager_.clear_all();
-        track_visualizer_.clear_all();
+        tracker_manager_.shrink_to_fit(); // 清空后突发扩容的块全部空闲，归还系统
+
+        // 画布由渲染线程清空，与点迹帧经同一信箱保持处理顺序
+        if (render_fps_ > 0 && render_mailbox_.post_clear())
+        {
+            stat_draw_frames_superseded_.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
     /*****************************************************************************
-     * @brief 点迹绘制请求
+     * @brief 点迹绘制请求，拷贝入参
      *
      * @param point 请求绘制的点迹
      *****************************************************************************/
     void ManagementService::draw_point_command(std::vector<TrackPoint> &point)
     {
-        std::lock_guard<std::mutex> lock(buffer_mutex_);
+        draw_point_command(trackmanager::BufferSpan<const TrackPoint>(point.data(), point.size()));
+    }
 
-        // 复制数据到缓冲区
-        draw_buffer_ = point;
+    /*****************************************************************************
+     * @brief 点迹绘制请求，数据移入指令
+     *
+     * @param point 请求绘制的点迹，调用后换成回收的空缓冲区
+     *****************************************************************************/
+    void ManagementService::draw_point_command(std::vector<TrackPoint> &&point)
+    {
+        // 与回收对象交换，调用方拿回其容量
+        auto *payload = draw_pool_.acquire();
+        payload->swap(point);
 
-        // 创建指令并加入队列
         Command cmd(CommandType::DRAW);
-        cmd.draw_data.point_data = &draw_buffer_;
+        cmd.draw_data.point_data = payload;
+        enqueue_command(cmd);
+    }
 
-        {
-            std::lock_guard<std::mutex> queue_lock(queue_mutex_);
-            command_queue_.push(cmd);
-            queue_cv_.notify_one();
-        }
+    /*****************************************************************************
+     * @brief 点迹绘制请求，拷贝到回收的缓冲区
+     *
+     * @param point 请求绘制的点迹
+     *****************************************************************************/
+    void ManagementService::draw_point_command(trackmanager::BufferSpan<const TrackPoint> point)
+    {
+        auto *payload = draw_pool_.acquire();
+        payload->assign(point.begin(), point.end());
 
-        std::cout << "ManagementService: 点迹绘制指令已加入队列，数量: " << point.size() << std::endl;
+        Command cmd(CommandType::DRAW);
+        cmd.draw_data.point_data = payload;
+        enqueue_command(cmd);
     }
 
     /*****************************************************************************
@@ -445,10 +812,17 @@ namespace track_project
     void ManagementService::process_draw(std::vector<TrackPoint> &point_data)
     {
         LOG_DEBUG << "ManagementService: 处理点迹绘制指令，数量: " << point_data.size() << std::endl;
-        
-        // 调用TrackerVisualizer的draw_point_cloud函数
-        track_visualizer_.draw_point_cloud(point_data);
-        
+
+        if (render_fps_ == 0)
+        {
+            return;
+        }
+
+        // 与工作线程持有的渲染帧交换，指令数据对象带回旧帧的缓冲区，随指令归还；被取代的点迹帧计数
+        if (render_mailbox_.post_points(point_data))
+        {
+            stat_draw_frames_superseded_.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
 } // namespace track_project
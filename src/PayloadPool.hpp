@@ -0,0 +1,78 @@
+/*****************************************************************************
+ * @file PayloadPool.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 指令数据对象池
+ * 1、每条指令独占一个数据对象（std::vector），处理完后清空归还，容量保留供下次复用
+ * 2、空闲对象放在有界无锁队列中，提交线程取出、工作线程归还均无锁
+ * 3、池空时新建对象，空闲队列已满时归还的对象直接释放，稳态下不再申请内存
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _PAYLOAD_POOL_HPP_
+#define _PAYLOAD_POOL_HPP_
+
+#include <vector>
+#include <cstddef>
+
+#include "BoundedMpmcQueue.hpp"
+
+namespace track_project::trackmanager
+{
+
+    template <typename T>
+    class PayloadPool
+    {
+    public:
+        using Payload = std::vector<T>;
+
+        /*****************************************************************************
+         * @brief 构造对象池
+         *
+         * @param capacity 最多缓存的空闲对象数
+         *****************************************************************************/
+        explicit PayloadPool(size_t capacity) : free_(capacity) {}
+
+        // 多线程共享，禁止拷贝，移动
+        PayloadPool(const PayloadPool &) = delete;
+        PayloadPool &operator=(const PayloadPool &) = delete;
+        PayloadPool(PayloadPool &&) = delete;
+        PayloadPool &operator=(PayloadPool &&) = delete;
+
+        ~PayloadPool()
+        {
+            Payload *payload;
+            while (free_.try_pop(payload))
+            {
+                delete payload;
+            }
+        }
+
+        // 取出一个空对象，池空时新建
+        Payload *acquire()
+        {
+            Payload *payload;
+            if (free_.try_pop(payload))
+                return payload;
+            return new Payload();
+        }
+
+        // 清空并归还对象，空闲队列已满时释放
+        void release(Payload *payload) noexcept
+        {
+            if (!payload)
+                return;
+            payload->clear();
+            if (!free_.try_push(payload))
+                delete payload;
+        }
+
+    private:
+        BoundedMpmcQueue<Payload *> free_;
+    };
+
+} // namespace track_project::trackmanager
+
+#endif // _PAYLOAD_POOL_HPP_
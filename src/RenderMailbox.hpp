@@ -0,0 +1,124 @@
+/*****************************************************************************
+ * @file RenderMailbox.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 工作线程到渲染线程的渲染帧信箱
+ * 1、三个渲染帧轮换，工作线程与渲染线程各持有一个，另一个在信箱中，投递与取走各一次原子交换
+ * 2、点迹帧与画布清空经同一信箱按投递顺序交给渲染线程；渲染线程未取走的旧帧被新帧取代
+ * 3、清空时清空代数加一，帧记录投递时的代数；被取代的清空帧由后续帧的代数补上，先清空后绘制的顺序不变
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _RENDER_MAILBOX_HPP_
+#define _RENDER_MAILBOX_HPP_
+
+#include <array>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+#include "../include/defstruct.h"
+
+namespace track_project::trackmanager
+{
+
+    class RenderMailbox
+    {
+        using TrackPoint = track_project::TrackPoint;
+
+    public:
+        RenderMailbox() = default;
+
+        // 两个线程共享，禁止拷贝，移动
+        RenderMailbox(const RenderMailbox &) = delete;
+        RenderMailbox &operator=(const RenderMailbox &) = delete;
+        RenderMailbox(RenderMailbox &&) = delete;
+        RenderMailbox &operator=(RenderMailbox &&) = delete;
+
+        ~RenderMailbox() = default;
+
+        /*****************************************************************************
+         * @brief 工作线程：投递点迹帧
+         *
+         * @param points 待绘制的点迹，调用后换成工作线程所持旧帧的缓冲区
+         * @return 是否取代了渲染线程尚未取走的点迹帧
+         *****************************************************************************/
+        bool post_points(std::vector<TrackPoint> &points)
+        {
+            Frame &frame = frames_[back_];
+            frame.points.swap(points);
+            frame.draw = true;
+            frame.clear_generation = clear_generation_;
+            return post();
+        }
+
+        /*****************************************************************************
+         * @brief 工作线程：投递画布清空
+         * @return 是否取代了渲染线程尚未取走的点迹帧
+         *****************************************************************************/
+        bool post_clear()
+        {
+            Frame &frame = frames_[back_];
+            frame.points.clear();
+            frame.draw = false;
+            frame.clear_generation = ++clear_generation_;
+            return post();
+        }
+
+        /*****************************************************************************
+         * @brief 渲染线程：取走最新一帧，清空代数变化时先调用clear()，再对点迹帧调用draw(points)
+         * @return 信箱中没有新帧时返回false，不调用回调
+         *****************************************************************************/
+        template <typename Clear, typename Draw>
+        bool take(Clear &&clear, Draw &&draw)
+        {
+            if (!(mailbox_.load(std::memory_order_acquire) & FRESH))
+                return false;
+
+            front_ = mailbox_.exchange(front_, std::memory_order_acq_rel) & INDEX_MASK;
+            const Frame &frame = frames_[front_];
+            if (frame.clear_generation != taken_clear_generation_)
+            {
+                clear();
+                taken_clear_generation_ = frame.clear_generation;
+            }
+            if (frame.draw)
+            {
+                draw(static_cast<const std::vector<TrackPoint> &>(frame.points));
+            }
+            return true;
+        }
+
+    private:
+        struct Frame
+        {
+            std::vector<TrackPoint> points;     // 待绘制的点迹
+            bool draw = false;                  // 是否绘制点迹，仅清空画布的帧为false
+            std::uint64_t clear_generation = 0; // 投递时的清空代数
+        };
+
+        // 工作线程所持帧放入信箱，换回的帧未被取走且为点迹帧时即被取代
+        bool post()
+        {
+            std::uint32_t previous = mailbox_.exchange(back_ | FRESH, std::memory_order_acq_rel);
+            back_ = previous & INDEX_MASK;
+            return (previous & FRESH) && frames_[back_].draw;
+        }
+
+        // 信箱低2位为帧下标，FRESH表示渲染线程尚未取走
+        static constexpr std::uint32_t INDEX_MASK = 3;
+        static constexpr std::uint32_t FRESH = 4;
+
+        std::array<Frame, 3> frames_;
+        std::atomic<std::uint32_t> mailbox_{1};
+        std::uint32_t back_ = 2;                      // 工作线程持有
+        std::uint32_t front_ = 0;                     // 渲染线程持有
+        std::uint64_t clear_generation_ = 0;          // 工作线程持有
+        std::uint64_t taken_clear_generation_ = 0;    // 渲染线程已执行到的清空代数
+    };
+
+} // namespace track_project::trackmanager
+
+#endif // _RENDER_MAILBOX_HPP_
@@ -0,0 +1,109 @@
+/*****************************************************************************
+ * @file SlotRing.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 空闲槽位先进先出环形队列
+ * 1、释放的槽位排到队尾，分配从队首取，所有空闲槽位轮流使用，代数均匀增长，不会少数槽位被反复复用而提前退役
+ * 2、容量为2的幂，下标按位与取模；满时翻倍并按队列顺序重排，元素个数不超过航迹槽位数
+ * 3、只在航迹管理器的写入线程使用，无同步
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _SLOT_RING_HPP_
+#define _SLOT_RING_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+namespace track_project::trackmanager
+{
+
+    class SlotRing
+    {
+    public:
+        SlotRing() = default;
+
+        bool empty() const noexcept { return size_ == 0; }
+        std::uint32_t size() const noexcept { return size_; }
+
+        // 队首为下一个分配的槽位
+        std::uint32_t front() const noexcept
+        {
+            assert(size_ > 0 && "空闲队列为空！");
+            return slots_[head_];
+        }
+
+        // 从队首数第index个
+        std::uint32_t operator[](std::uint32_t index) const noexcept { return slots_[(head_ + index) & mask_]; }
+
+        void pop_front() noexcept
+        {
+            assert(size_ > 0 && "空闲队列为空！");
+            head_ = (head_ + 1) & mask_;
+            size_--;
+        }
+
+        void push_back(std::uint32_t slot)
+        {
+            if (size_ == slots_.size())
+                reserve(size_ + 1);
+            slots_[(head_ + size_) & mask_] = slot;
+            size_++;
+        }
+
+        void clear() noexcept
+        {
+            head_ = 0;
+            size_ = 0;
+        }
+
+        // 预留至少count个位置，按队列顺序重排到数组开头
+        void reserve(std::uint32_t count)
+        {
+            if (count <= slots_.size())
+                return;
+            size_t new_size = slots_.empty() ? MIN_SIZE : slots_.size();
+            while (new_size < count)
+            {
+                new_size <<= 1;
+            }
+            std::vector<std::uint32_t> slots(new_size);
+            for (std::uint32_t i = 0; i < size_; ++i)
+            {
+                slots[i] = (*this)[i];
+            }
+            slots_.swap(slots);
+            mask_ = static_cast<std::uint32_t>(new_size - 1);
+            head_ = 0;
+        }
+
+        // 删除满足条件的槽位，其余保持原顺序
+        template <typename Predicate>
+        void remove_if(Predicate &&predicate)
+        {
+            std::uint32_t kept = 0;
+            for (std::uint32_t i = 0; i < size_; ++i)
+            {
+                std::uint32_t slot = (*this)[i];
+                if (!predicate(slot))
+                    slots_[(head_ + kept++) & mask_] = slot;
+            }
+            size_ = kept;
+        }
+
+    private:
+        static constexpr size_t MIN_SIZE = 64;
+
+        std::vector<std::uint32_t> slots_;
+        std::uint32_t mask_ = 0;
+        std::uint32_t head_ = 0;
+        std::uint32_t size_ = 0;
+    };
+
+} // namespace track_project::trackmanager
+
+#endif // _SLOT_RING_HPP_
@@ -0,0 +1,167 @@
+#include "SpatialGrid.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace track_project::trackmanager
+{
+
+    SpatialGrid::SpatialGrid(std::uint32_t slot_count, double cell_degree)
+        : slots_(slot_count),
+          cell_degree_(cell_degree),
+          inv_cell_degree_(1.0 / cell_degree)
+    {
+        assert(cell_degree > 0.0 && "网格边长必须为正！");
+    }
+
+    // 超出int32范围的网格号钳位到两端（保持单调，范围查询仍能覆盖），非有限值由调用方事先排除
+    std::int32_t SpatialGrid::cell_index(double degree) const
+    {
+        constexpr double MIN_INDEX = std::numeric_limits<std::int32_t>::min();
+        constexpr double MAX_INDEX = std::numeric_limits<std::int32_t>::max();
+        const double index = std::floor(degree * inv_cell_degree_);
+        if (!(index > MIN_INDEX)) // 含NaN
+            return std::numeric_limits<std::int32_t>::min();
+        if (index > MAX_INDEX)
+            return std::numeric_limits<std::int32_t>::max();
+        return static_cast<std::int32_t>(index);
+    }
+
+    // 同网格只改坐标，跨网格时先交换删除再插入新桶；坐标非有限值时视为位置无效，移出索引
+    void SpatialGrid::update(std::uint32_t slot, std::uint32_t track_id, double longitude, double latitude)
+    {
+        if (!std::isfinite(longitude) || !std::isfinite(latitude))
+        {
+            remove(slot);
+            return;
+        }
+
+        SlotRef &ref = slots_[slot];
+        std::uint64_t key = pack_key(cell_index(longitude), cell_index(latitude));
+
+        if (ref.cell && ref.key == key)
+        {
+            Entry &entry = (*ref.cell)[ref.pos];
+            entry.longitude = longitude;
+            entry.latitude = latitude;
+            entry.track_id = track_id;
+            return;
+        }
+
+        remove(slot);
+
+        Cell &cell = cells_[key];
+        ref.key = key;
+        ref.cell = &cell;
+        ref.pos = static_cast<std::uint32_t>(cell.size());
+        cell.push_back(Entry{longitude, latitude, track_id, slot});
+        count_++;
+    }
+
+    // 交换删除：桶末尾条目填补空位；空桶保留，避免航迹来回穿越网格时反复建桶
+    void SpatialGrid::remove(std::uint32_t slot)
+    {
+        SlotRef &ref = slots_[slot];
+        if (!ref.cell)
+            return;
+
+        Cell &cell = *ref.cell;
+        const Entry &last = cell.back();
+        cell[ref.pos] = last;
+        slots_[last.slot].pos = ref.pos;
+        cell.pop_back();
+
+        ref.cell = nullptr;
+        count_--;
+    }
+
+    void SpatialGrid::clear()
+    {
+        cells_.clear();
+        for (SlotRef &ref : slots_)
+        {
+            ref.cell = nullptr;
+        }
+        count_ = 0;
+    }
+
+    void SpatialGrid::reset(std::uint32_t slot_count)
+    {
+        clear();
+        slots_.resize(slot_count);
+    }
+
+    template <typename Visitor>
+    void SpatialGrid::visit_range(double min_longitude, double min_latitude, double max_longitude, double max_latitude,
+                                  Visitor &&visitor) const
+    {
+        // 写成取反形式，任一边界为NaN时同样直接返回；无穷边界钳位到最外侧网格
+        if (count_ == 0 || !(min_longitude <= max_longitude && min_latitude <= max_latitude))
+            return;
+
+        std::int64_t ix0 = cell_index(min_longitude), ix1 = cell_index(max_longitude);
+        std::int64_t iy0 = cell_index(min_latitude), iy1 = cell_index(max_latitude);
+        // 钳位后两个方向各可达2^32个网格，乘积按浮点计算避免溢出
+        const double range_cells = double(ix1 - ix0 + 1) * double(iy1 - iy0 + 1);
+
+        if (range_cells > static_cast<double>(cells_.size()))
+        {
+            for (const auto &kv : cells_)
+            {
+                for (const Entry &entry : kv.second)
+                    visitor(entry);
+            }
+            return;
+        }
+
+        for (std::int64_t ix = ix0; ix <= ix1; ++ix)
+        {
+            for (std::int64_t iy = iy0; iy <= iy1; ++iy)
+            {
+                auto it = cells_.find(pack_key(static_cast<std::int32_t>(ix), static_cast<std::int32_t>(iy)));
+                if (it == cells_.end())
+                    continue;
+                for (const Entry &entry : it->second)
+                    visitor(entry);
+            }
+        }
+    }
+
+    // 先按外接矩形筛选网格，再按局部等距投影精确判断距离；中心非有限值、半径为负或NaN时无结果
+    void SpatialGrid::query_radius(double longitude, double latitude, double radius_m,
+                                   std::vector<std::uint32_t> &track_ids) const
+    {
+        if (!(radius_m >= 0.0) || !std::isfinite(longitude) || !std::isfinite(latitude))
+            return;
+
+        constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+        const double meters_per_lon = METERS_PER_DEGREE * std::max(std::cos(latitude * DEG_TO_RAD), 1e-6);
+        const double dlat = radius_m / METERS_PER_DEGREE;
+        const double dlon = std::min(radius_m / meters_per_lon, 360.0);
+        const double radius_sq = radius_m * radius_m;
+
+        visit_range(longitude - dlon, latitude - dlat, longitude + dlon, latitude + dlat,
+                    [&](const Entry &entry)
+                    {
+                        double dx = (entry.longitude - longitude) * meters_per_lon;
+                        double dy = (entry.latitude - latitude) * METERS_PER_DEGREE;
+                        if (dx * dx + dy * dy <= radius_sq)
+                            track_ids.push_back(entry.track_id);
+                    });
+    }
+
+    void SpatialGrid::query_box(double min_longitude, double min_latitude, double max_longitude, double max_latitude,
+                                std::vector<std::uint32_t> &track_ids) const
+    {
+        visit_range(min_longitude, min_latitude, max_longitude, max_latitude,
+                    [&](const Entry &entry)
+                    {
+                        if (entry.longitude >= min_longitude && entry.longitude <= max_longitude &&
+                            entry.latitude >= min_latitude && entry.latitude <= max_latitude)
+                            track_ids.push_back(entry.track_id);
+                    });
+    }
+
+} // namespace track_project::trackmanager
@@ -0,0 +1,128 @@
+/*****************************************************************************
+ * @file SpatialGrid.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 航迹最新位置的均匀经纬度网格索引
+ * 1、经纬度按固定步长划分网格，只为出现过航迹的网格建桶（哈希表），内存与航迹数成正比
+ * 2、每个槽位记录所在网格及桶内位置，同网格内移动只改坐标，跨网格移动与删除均为O(1)
+ * 3、提供圆形范围查询与经纬度矩形查询，只访问覆盖范围内的网格
+ * @version 0.1
+ * @date 2025-12-11
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _SPATIAL_GRID_HPP_
+#define _SPATIAL_GRID_HPP_
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+namespace track_project::trackmanager
+{
+
+    class SpatialGrid
+    {
+    public:
+        // 每度纬度对应的距离（米），经度方向再乘以cos(纬度)
+        static constexpr double METERS_PER_DEGREE = 111000.0;
+
+        /*****************************************************************************
+         * @brief 构造网格索引
+         *
+         * @param slot_count 槽位数量上限
+         * @param cell_degree 网格边长（度），默认0.01度约1.1km
+         *****************************************************************************/
+        explicit SpatialGrid(std::uint32_t slot_count, double cell_degree = 0.01);
+
+        // 跟随航迹管理器，禁止拷贝，移动
+        SpatialGrid(const SpatialGrid &) = delete;
+        SpatialGrid &operator=(const SpatialGrid &) = delete;
+        SpatialGrid(SpatialGrid &&) = delete;
+        SpatialGrid &operator=(SpatialGrid &&) = delete;
+
+        ~SpatialGrid() = default;
+
+        /*****************************************************************************
+         * @brief 更新槽位的最新位置，槽位不在索引中时插入；经纬度非有限值时移出索引
+         *****************************************************************************/
+        void update(std::uint32_t slot, std::uint32_t track_id, double longitude, double latitude);
+
+        // 槽位移出索引，不在索引中时忽略
+        void remove(std::uint32_t slot);
+
+        // 清空索引并释放全部网格桶
+        void clear();
+
+        // 清空索引并调整槽位数量上限
+        void reset(std::uint32_t slot_count);
+
+        // 扩展槽位数量上限，已有索引不变
+        void grow(std::uint32_t slot_count)
+        {
+            if (slot_count > slots_.size())
+                slots_.resize(slot_count);
+        }
+
+        /*****************************************************************************
+         * @brief 圆形范围查询，结果追加到track_ids末尾，顺序不定
+         *
+         * @param radius_m 半径（米），按局部等距投影计算距离；为无穷大时返回全部航迹
+         *****************************************************************************/
+        void query_radius(double longitude, double latitude, double radius_m,
+                          std::vector<std::uint32_t> &track_ids) const;
+
+        /*****************************************************************************
+         * @brief 经纬度矩形查询（含边界），结果追加到track_ids末尾，顺序不定
+         * 边界可为无穷大，任一边界为NaN或下界大于上界时无结果
+         *****************************************************************************/
+        void query_box(double min_longitude, double min_latitude, double max_longitude, double max_latitude,
+                       std::vector<std::uint32_t> &track_ids) const;
+
+        // 统计信息
+        size_t size() const noexcept { return count_; }
+        size_t cell_count() const noexcept { return cells_.size(); }
+        double cell_degree() const noexcept { return cell_degree_; }
+
+    private:
+        struct Entry
+        {
+            double longitude;
+            double latitude;
+            std::uint32_t track_id;
+            std::uint32_t slot;
+        };
+
+        using Cell = std::vector<Entry>;
+
+        // 槽位 -> 所在网格，哈希表节点地址稳定，可直接保存桶指针
+        struct SlotRef
+        {
+            std::uint64_t key = 0;
+            Cell *cell = nullptr; // 为空表示不在索引中
+            std::uint32_t pos = 0;
+        };
+
+        std::int32_t cell_index(double degree) const;
+
+        static std::uint64_t pack_key(std::int32_t ix, std::int32_t iy)
+        {
+            return (std::uint64_t(std::uint32_t(ix)) << 32) | std::uint32_t(iy);
+        }
+
+        // 遍历矩形网格范围内的全部条目，范围内网格数多于已有桶数时改为遍历全部桶
+        template <typename Visitor>
+        void visit_range(double min_longitude, double min_latitude, double max_longitude, double max_latitude,
+                         Visitor &&visitor) const;
+
+        std::unordered_map<std::uint64_t, Cell> cells_;
+        std::vector<SlotRef> slots_;
+        size_t count_ = 0;
+        double cell_degree_;
+        double inv_cell_degree_;
+    };
+
+} // namespace track_project::trackmanager
+
+#endif // _SPATIAL_GRID_HPP_
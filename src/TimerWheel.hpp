@@ -0,0 +1,243 @@
+/*****************************************************************************
+ * @file TimerWheel.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 航迹静默超时的分层时间轮
+ * 1、按航迹最后更新时间挂入分层时间轮：第0层256格，其上3层各64格，超出范围的挂到最远一格
+ * 2、写入点迹时不移动条目，到期时才回调读取航迹真实的最后更新时间，未超时则重新挂入，写入路径零开销
+ * 3、推进时只访问到期的格子，代价与到期条目数成正比，空闲区间整段跳过，与航迹总数无关
+ * 4、槽位被删除或复用后旧条目在到期时由回调识别并丢弃，删除航迹无需通知时间轮
+ * @version 0.1
+ * @date 2025-12-13
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _TIMER_WHEEL_HPP_
+#define _TIMER_WHEEL_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+namespace track_project::trackmanager
+{
+
+    class TimerWheel
+    {
+    public:
+        /*****************************************************************************
+         * @brief 构造时间轮
+         *
+         * @param start_ms 起始时刻（毫秒），推进前创建的航迹以该时刻为最后更新时间
+         * @param tick_ms 刻度（毫秒），即超时判定的精度
+         *****************************************************************************/
+        explicit TimerWheel(std::int64_t start_ms, std::int64_t tick_ms = 100)
+            : tick_ms_(tick_ms), now_ms_(start_ms)
+        {
+            assert(tick_ms > 0 && "时间轮刻度必须为正！");
+            cursor_ = to_tick(start_ms);
+            for (std::uint32_t level = 0; level < LEVEL_COUNT; ++level)
+            {
+                buckets_[level].resize(std::size_t(1) << level_bits(level));
+            }
+        }
+
+        // 跟随航迹管理器，禁止拷贝，移动
+        TimerWheel(const TimerWheel &) = delete;
+        TimerWheel &operator=(const TimerWheel &) = delete;
+        TimerWheel(TimerWheel &&) = delete;
+        TimerWheel &operator=(TimerWheel &&) = delete;
+
+        ~TimerWheel() = default;
+
+        // 新航迹挂入时间轮，以最近一次推进的当前时刻为最后更新时间
+        void schedule(std::uint32_t slot, std::uint32_t track_id)
+        {
+            insert(Entry{0, now_ms_, slot, track_id}, to_tick(now_ms_));
+            count_++;
+        }
+
+        /*****************************************************************************
+         * @brief 推进时间轮，最后更新时间早于 now_ms - timeout_ms 的航迹ID追加到expired_ids
+         *
+         * @param refresh 可调用对象，签名 bool(std::uint32_t slot, std::uint32_t track_id, std::int64_t &last_ms)
+         * 条目已失效（航迹已删除）返回false；否则将last_ms更新为航迹当前的最后更新时间
+         *****************************************************************************/
+        template <typename Refresh>
+        void advance(std::int64_t now_ms, std::int64_t timeout_ms, Refresh &&refresh,
+                     std::vector<std::uint32_t> &expired_ids)
+        {
+            if (now_ms > now_ms_)
+                now_ms_ = now_ms;
+            const std::int64_t horizon_ms = now_ms - timeout_ms;
+            const std::int64_t target = to_tick(horizon_ms);
+
+            // 插入时已落后于游标的条目
+            drain(due_, horizon_ms, refresh, expired_ids);
+
+            while (cursor_ < target)
+            {
+                if (count_ == 0)
+                {
+                    cursor_ = target;
+                    break;
+                }
+
+                std::uint32_t index = static_cast<std::uint32_t>(cursor_ & LEVEL0_MASK);
+                if (index == 0)
+                {
+                    cascade();
+                }
+
+                // 第0层为空时直接跳到下一次级联的位置
+                if (level0_count_ == 0)
+                {
+                    std::int64_t next = (cursor_ | LEVEL0_MASK) + 1;
+                    cursor_ = next < target ? next : target;
+                    continue;
+                }
+
+                std::vector<Entry> &bucket = buckets_[0][index];
+                level0_count_ -= bucket.size();
+                drain(bucket, horizon_ms, refresh, expired_ids);
+                cursor_++;
+            }
+        }
+
+        // 丢弃全部条目，游标保持不变
+        void clear()
+        {
+            for (auto &level : buckets_)
+            {
+                for (auto &bucket : level)
+                {
+                    bucket.clear();
+                }
+            }
+            due_.clear();
+            count_ = 0;
+            level0_count_ = 0;
+        }
+
+        // 统计信息，包含尚未识别的失效条目
+        size_t size() const noexcept { return count_; }
+        std::int64_t tick_ms() const noexcept { return tick_ms_; }
+
+    private:
+        struct Entry
+        {
+            std::int64_t tick;    // 所在刻度，超出范围时为截断后的刻度
+            std::int64_t time_ms; // 挂入时的最后更新时间
+            std::uint32_t slot;
+            std::uint32_t track_id;
+        };
+
+        // 第0层256格，第1~3层各64格，共覆盖2^26个刻度
+        static constexpr std::uint32_t LEVEL_COUNT = 4;
+        static constexpr std::uint32_t LEVEL0_BITS = 8;
+        static constexpr std::uint32_t LEVEL_BITS = 6;
+        static constexpr std::int64_t LEVEL0_MASK = (std::int64_t(1) << LEVEL0_BITS) - 1;
+        static constexpr std::int64_t MAX_SPAN = std::int64_t(1) << (LEVEL0_BITS + LEVEL_BITS * (LEVEL_COUNT - 1));
+
+        static constexpr std::uint32_t level_bits(std::uint32_t level) { return level == 0 ? LEVEL0_BITS : LEVEL_BITS; }
+        static constexpr std::uint32_t level_shift(std::uint32_t level) { return level == 0 ? 0 : LEVEL0_BITS + LEVEL_BITS * (level - 1); }
+
+        // 向下取整的刻度
+        std::int64_t to_tick(std::int64_t time_ms) const
+        {
+            std::int64_t tick = time_ms / tick_ms_;
+            return (time_ms % tick_ms_ < 0) ? tick - 1 : tick;
+        }
+
+        // 按距游标的远近选择层级，超出范围的截断到最远一格，到期时由回调重新挂入
+        void insert(Entry entry, std::int64_t tick)
+        {
+            if (tick < cursor_)
+            {
+                entry.tick = tick;
+                due_.push_back(entry);
+                return;
+            }
+            if (tick - cursor_ >= MAX_SPAN)
+            {
+                tick = cursor_ + MAX_SPAN - 1;
+            }
+            entry.tick = tick;
+
+            std::int64_t delta = tick - cursor_;
+            for (std::uint32_t level = 0; level < LEVEL_COUNT; ++level)
+            {
+                std::uint32_t range_bits = level_shift(level) + level_bits(level);
+                if (delta < (std::int64_t(1) << range_bits) || level + 1 == LEVEL_COUNT)
+                {
+                    std::int64_t mask = (std::int64_t(1) << level_bits(level)) - 1;
+                    buckets_[level][(tick >> level_shift(level)) & mask].push_back(entry);
+                    level0_count_ += (level == 0);
+                    return;
+                }
+            }
+        }
+
+        // 游标到达第0层起点时，把上层对应格子的条目重新分配到下层，逐层进行直到某层未回绕
+        void cascade()
+        {
+            for (std::uint32_t level = 1; level < LEVEL_COUNT; ++level)
+            {
+                std::int64_t mask = (std::int64_t(1) << level_bits(level)) - 1;
+                std::uint32_t index = static_cast<std::uint32_t>((cursor_ >> level_shift(level)) & mask);
+
+                scratch_.swap(buckets_[level][index]);
+                for (const Entry &entry : scratch_)
+                {
+                    insert(entry, entry.tick);
+                }
+                scratch_.clear();
+
+                if (index != 0)
+                    break;
+            }
+        }
+
+        // 处理到期格子：失效条目丢弃，超时条目输出，仍有更新的条目按新时间重新挂入
+        template <typename Refresh>
+        void drain(std::vector<Entry> &bucket, std::int64_t horizon_ms, Refresh &refresh,
+                   std::vector<std::uint32_t> &expired_ids)
+        {
+            if (bucket.empty())
+                return;
+
+            scratch_.swap(bucket);
+            for (Entry &entry : scratch_)
+            {
+                if (!refresh(entry.slot, entry.track_id, entry.time_ms))
+                {
+                    count_--;
+                }
+                else if (entry.time_ms < horizon_ms)
+                {
+                    expired_ids.push_back(entry.track_id);
+                    count_--;
+                }
+                else
+                {
+                    insert(entry, to_tick(entry.time_ms));
+                }
+            }
+            scratch_.clear();
+        }
+
+        std::vector<std::vector<Entry>> buckets_[LEVEL_COUNT];
+        std::vector<Entry> due_;     // 挂入时刻度已落后于游标的条目
+        std::vector<Entry> scratch_; // 级联与到期处理时的暂存，复用避免反复申请
+
+        std::int64_t tick_ms_;
+        std::int64_t now_ms_;      // 最近一次推进的当前时刻
+        std::int64_t cursor_;      // 下一个待处理的刻度
+        size_t count_ = 0;         // 条目总数
+        size_t level0_count_ = 0;  // 第0层条目数
+    };
+
+} // namespace track_project::trackmanager
+
+#endif // _TIMER_WHEEL_HPP_
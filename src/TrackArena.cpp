@@ -0,0 +1,79 @@
+#include "TrackArena.hpp"
+#include "../utils/Logger.hpp"
+
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace track_project::trackmanager
+{
+
+    // 大页尺寸，x86_64下默认2MB
+    constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    TrackArena::TrackArena(size_t bytes, bool use_huge_pages)
+        : base_(nullptr), size_(0), used_(0), huge_pages_(false)
+    {
+        assert(bytes > 0 && "申请了过小的内存！");
+
+        void *ptr = MAP_FAILED;
+
+        // 1. 尝试显式大页，依赖系统预留hugetlbfs页面，失败很常见
+        if (use_huge_pages)
+        {
+            size_ = (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+            ptr = mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_HUGETLB, -1, 0);
+            huge_pages_ = (ptr != MAP_FAILED);
+            if (!huge_pages_)
+            {
+                LOG_DEBUG << "TrackArena: MAP_HUGETLB 申请失败，退化为普通页";
+            }
+        }
+
+        // 2. 普通页映射
+        if (ptr == MAP_FAILED)
+        {
+            size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            size_ = (bytes + page_size - 1) & ~(page_size - 1);
+            ptr = mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (ptr == MAP_FAILED)
+            {
+                LOG_ERROR << "TrackArena: 申请" << bytes << "字节存储区失败";
+                throw std::bad_alloc();
+            }
+
+            // 请求透明大页，不成功不影响功能
+            if (use_huge_pages)
+            {
+                madvise(ptr, size_, MADV_HUGEPAGE);
+            }
+        }
+
+        base_ = static_cast<std::uint8_t *>(ptr);
+    }
+
+    // 只处理完整覆盖的页，避免误伤相邻块
+    size_t TrackArena::discard(void *ptr, size_t bytes) noexcept
+    {
+        size_t page_size = huge_pages_ ? HUGE_PAGE_SIZE : static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        std::uintptr_t begin = (reinterpret_cast<std::uintptr_t>(ptr) + page_size - 1) & ~(page_size - 1);
+        std::uintptr_t end = (reinterpret_cast<std::uintptr_t>(ptr) + bytes) & ~(page_size - 1);
+        if (end <= begin)
+            return 0;
+
+        if (madvise(reinterpret_cast<void *>(begin), end - begin, MADV_DONTNEED) != 0)
+            return 0;
+        return end - begin;
+    }
+
+    TrackArena::~TrackArena()
+    {
+        if (base_)
+        {
+            munmap(base_, size_);
+        }
+    }
+
+} // namespace track_project::trackmanager
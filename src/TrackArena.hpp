@@ -0,0 +1,101 @@
+/*****************************************************************************
+ * @file TrackArena.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 航迹点存储区
+ * 1、构造时通过mmap一次性申请整块对齐内存，所有航迹缓冲区从中切分，析构时整体释放
+ * 2、可选大页：优先MAP_HUGETLB，失败时退化为普通页并通过madvise请求透明大页
+ * 3、只支持顺序切分，不支持单独归还，生命周期与持有者一致；空闲区域可通过discard把物理页还给系统
+ * 4、剩余空间不足时切分返回nullptr，由调用方决定如何处理
+ * @version 0.1
+ * @date 2025-12-08
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _TRACK_ARENA_HPP_
+#define _TRACK_ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <cassert>
+
+namespace track_project::trackmanager
+{
+
+    class TrackArena
+    {
+    public:
+        // 切分对齐，按缓存行对齐避免相邻航迹共享缓存行
+        static constexpr size_t ALIGNMENT = 64;
+
+        /*****************************************************************************
+         * @brief 申请存储区，内存不足时抛出 std::bad_alloc
+         *
+         * @param bytes 需要的字节数
+         * @param use_huge_pages 是否尝试使用大页
+         *****************************************************************************/
+        explicit TrackArena(size_t bytes, bool use_huge_pages = false);
+
+        ~TrackArena();
+
+        // 独占映射区，禁止拷贝，移动
+        TrackArena(const TrackArena &) = delete;
+        TrackArena &operator=(const TrackArena &) = delete;
+        TrackArena(TrackArena &&) = delete;
+        TrackArena &operator=(TrackArena &&) = delete;
+
+        /*****************************************************************************
+         * @brief 顺序切分count个T，返回的地址按ALIGNMENT对齐
+         * 平凡可拷贝且平凡析构的类型直接使用映射得到的零页，对象由首次赋值写入建立，
+         * 从而保持未写入页不驻留；其他类型就地默认构造
+         * @return 切分得到的首地址，剩余空间不足时返回nullptr且不占用空间
+         *****************************************************************************/
+        template <typename T>
+        T *carve(size_t count)
+        {
+            // 先按元素数比较，避免count * sizeof(T)溢出
+            if (count > (size_ - used_) / sizeof(T))
+                return nullptr;
+            size_t bytes = align_up(count * sizeof(T));
+            if (bytes > size_ - used_)
+                return nullptr;
+
+            T *ptr = reinterpret_cast<T *>(base_ + used_);
+            used_ += bytes;
+
+            if constexpr (!(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>))
+            {
+                std::uninitialized_default_construct_n(ptr, count);
+            }
+            return ptr;
+        }
+
+        /*****************************************************************************
+         * @brief 将[ptr, ptr+bytes)内完整覆盖的页归还操作系统，地址仍然有效，再次写入时按零页重新分配
+         * @return 实际归还的字节数
+         *****************************************************************************/
+        size_t discard(void *ptr, size_t bytes) noexcept;
+
+        // 计算count个T切分后实际占用的字节数
+        template <typename T>
+        static size_t bytes_for(size_t count) { return align_up(count * sizeof(T)); }
+
+        // 基本信息
+        size_t size_bytes() const noexcept { return size_; }
+        size_t used_bytes() const noexcept { return used_; }
+        bool huge_pages() const noexcept { return huge_pages_; }
+
+    private:
+        static size_t align_up(size_t bytes) noexcept { return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+        std::uint8_t *base_; // 映射区首地址
+        size_t size_;        // 映射区大小（按页取整）
+        size_t used_;        // 已切分字节数
+        bool huge_pages_;    // 是否成功使用MAP_HUGETLB
+    };
+
+} // namespace track_project::trackmanager
+
+#endif // _TRACK_ARENA_HPP_
@@ -0,0 +1,326 @@
+/*****************************************************************************
+ * @file TrackCheckpoint.cpp
+ * @brief TrackerManager 检查点保存与恢复
+ * 1、保存：按段顺序写入临时文件，点迹直接从环形缓冲区的两段视图写出，落盘后原子改名，再同步所在目录
+ * 2、恢复：mmap映射文件，先完整校验再修改管理器，每条航迹从映射区一次拷贝进点迹存储
+ *
+ * @version 0.1
+ * @date 2025-12-13
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TrackerManager.hpp"
+#include "TrackCheckpoint.hpp"
+#include "../utils/Logger.hpp"
+
+#include <cstdio>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace track_project::trackmanager
+{
+
+    namespace
+    {
+        // 写入缓冲区大小
+        constexpr size_t WRITE_BUFFER_BYTES = 1 << 20;
+
+        // 写入一段并补齐到段对齐
+        bool write_section(std::FILE *file, const void *data, size_t bytes)
+        {
+            static const char padding[CHECKPOINT_ALIGNMENT] = {};
+            if (bytes > 0 && std::fwrite(data, 1, bytes, file) != bytes)
+                return false;
+            size_t pad = checkpoint_align(bytes) - bytes;
+            return pad == 0 || std::fwrite(padding, 1, pad, file) == pad;
+        }
+
+        // 同步文件所在目录，使改名本身落盘
+        bool sync_parent_directory(const std::string &path)
+        {
+            const size_t pos = path.find_last_of('/');
+            const std::string directory = pos == std::string::npos ? "." : (pos == 0 ? "/" : path.substr(0, pos));
+            int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+            if (fd < 0)
+                return false;
+            bool ok = ::fsync(fd) == 0;
+            ::close(fd);
+            return ok;
+        }
+
+        // 只读映射整个文件，析构时解除映射
+        class MappedFile
+        {
+        public:
+            explicit MappedFile(const std::string &path)
+            {
+                int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0)
+                    return;
+                struct stat st;
+                if (::fstat(fd, &st) == 0 && st.st_size > 0)
+                {
+                    void *ptr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+                    if (ptr != MAP_FAILED)
+                    {
+                        data_ = static_cast<const char *>(ptr);
+                        size_ = static_cast<size_t>(st.st_size);
+                        ::madvise(ptr, size_, MADV_SEQUENTIAL);
+                    }
+                }
+                ::close(fd);
+            }
+
+            ~MappedFile()
+            {
+                if (data_)
+                    ::munmap(const_cast<char *>(data_), size_);
+            }
+
+            MappedFile(const MappedFile &) = delete;
+            MappedFile &operator=(const MappedFile &) = delete;
+
+            const char *data() const noexcept { return data_; }
+            size_t size() const noexcept { return size_; }
+
+        private:
+            const char *data_ = nullptr;
+            size_t size_ = 0;
+        };
+    }
+
+    // 保存检查点：先写临时文件，完成后改名，中途失败不破坏已有检查点
+    bool TrackerManager::save_checkpoint(const std::string &path) const
+    {
+        const std::string temp_path = path + ".tmp";
+        std::FILE *file = std::fopen(temp_path.c_str(), "wb");
+        if (!file)
+        {
+            LOG_ERROR << "检查点保存失败，无法创建文件" << temp_path;
+            return false;
+        }
+        std::setvbuf(file, nullptr, _IOFBF, WRITE_BUFFER_BYTES);
+
+        CheckpointHeader header{};
+        std::copy(std::begin(CHECKPOINT_MAGIC), std::end(CHECKPOINT_MAGIC), header.magic);
+        header.version = CHECKPOINT_VERSION;
+        header.header_bytes = sizeof(TrackerHeader);
+        header.point_bytes = sizeof(TrackPoint);
+        header.track_length = track_length;
+        header.index_bits = index_bits_;
+        header.capacity = capacity_;
+        header.active_count = static_cast<std::uint32_t>(active_ids_.size());
+        header.high_water_mark = high_water_mark_;
+        header.point_count = 0;
+
+        // 空闲列表按分配顺序保存
+        std::vector<std::uint32_t> free_slots;
+        free_slots.reserve(free_slots_.size());
+        for (std::uint32_t i = 0; i < free_slots_.size(); ++i)
+        {
+            free_slots.push_back(free_slots_[i]);
+        }
+        header.free_count = static_cast<std::uint32_t>(free_slots.size());
+
+        std::vector<CheckpointTrack> tracks(active_ids_.size());
+        for (size_t i = 0; i < active_ids_.size(); ++i)
+        {
+            std::uint32_t slot = slot_of(active_ids_[i]);
+            const TrackBuffer &buffer = buffer_at(slot);
+            tracks[i].header = header_at(slot);
+            tracks[i].size_class = buffer.size_class;
+            tracks[i].point_count = static_cast<std::uint32_t>(buffer.data.size());
+            header.point_count += buffer.data.size();
+        }
+
+        bool ok = write_section(file, &header, sizeof(header)) &&
+                  write_section(file, slot_generations_.data(), capacity_ * sizeof(std::uint32_t)) &&
+                  write_section(file, free_slots.data(), free_slots.size() * sizeof(std::uint32_t)) &&
+                  write_section(file, active_ids_.data(), active_ids_.size() * sizeof(std::uint32_t)) &&
+                  write_section(file, tracks.data(), tracks.size() * sizeof(CheckpointTrack));
+
+        // 点迹按逻辑顺序写出，环形缓冲区最多两段
+        for (size_t i = 0; ok && i < active_ids_.size(); ++i)
+        {
+            auto segments = buffer_at(slot_of(active_ids_[i])).data.segments();
+            ok = write_section(file, segments.first.data(), segments.first.size() * sizeof(TrackPoint)) &&
+                 write_section(file, segments.second.data(), segments.second.size() * sizeof(TrackPoint));
+        }
+
+        // 数据落盘后才改名，掉电后要么是完整的新检查点，要么是旧检查点
+        ok = ok && std::fflush(file) == 0 && ::fsync(::fileno(file)) == 0;
+        ok = (std::fclose(file) == 0) && ok;
+        if (!ok || std::rename(temp_path.c_str(), path.c_str()) != 0)
+        {
+            LOG_ERROR << "检查点保存失败，写入" << path << "出错";
+            std::remove(temp_path.c_str());
+            return false;
+        }
+        if (!sync_parent_directory(path))
+        {
+            LOG_ERROR << "检查点目录同步失败，掉电后可能仍为旧检查点：" << path;
+        }
+
+        LOG_INFO << "检查点已保存：" << path << "，航迹" << header.active_count << "条，点迹" << header.point_count << "个";
+        return true;
+    }
+
+    // 恢复检查点：校验全部段后再清空并重建，校验失败时管理器保持原状
+    bool TrackerManager::load_checkpoint(const std::string &path)
+    {
+        MappedFile file(path);
+        if (!file.data() || file.size() < sizeof(CheckpointHeader))
+        {
+            LOG_ERROR << "检查点恢复失败，无法映射文件" << path;
+            return false;
+        }
+
+        // 1.校验文件头
+        const CheckpointHeader &header = *reinterpret_cast<const CheckpointHeader *>(file.data());
+        if (!std::equal(std::begin(CHECKPOINT_MAGIC), std::end(CHECKPOINT_MAGIC), header.magic) ||
+            header.version != CHECKPOINT_VERSION ||
+            header.header_bytes != sizeof(TrackerHeader) || header.point_bytes != sizeof(TrackPoint))
+        {
+            LOG_ERROR << "检查点恢复失败，文件格式或版本不符：" << path;
+            return false;
+        }
+        if (header.track_length != track_length || header.index_bits != index_bits_ ||
+            header.capacity > track_ceiling_ || header.free_count > header.capacity ||
+            header.active_count > header.capacity)
+        {
+            LOG_ERROR << "检查点恢复失败，航迹长度、ID编码或容量与当前管理器不符：" << path;
+            return false;
+        }
+
+        // 2.定位各段并校验文件长度
+        size_t offset = sizeof(CheckpointHeader);
+        auto section = [&](size_t bytes)
+        {
+            const char *ptr = file.data() + offset;
+            offset += checkpoint_align(bytes);
+            return ptr;
+        };
+        const auto *generations = reinterpret_cast<const std::uint32_t *>(section(header.capacity * sizeof(std::uint32_t)));
+        const auto *free_slots = reinterpret_cast<const std::uint32_t *>(section(header.free_count * sizeof(std::uint32_t)));
+        const auto *active_ids = reinterpret_cast<const std::uint32_t *>(section(header.active_count * sizeof(std::uint32_t)));
+        const auto *tracks = reinterpret_cast<const CheckpointTrack *>(section(header.active_count * sizeof(CheckpointTrack)));
+        const size_t points_offset = offset;
+        if (points_offset > file.size() || (file.size() - points_offset) / sizeof(TrackPoint) < header.point_count)
+        {
+            LOG_ERROR << "检查点恢复失败，文件被截断：" << path;
+            return false;
+        }
+
+        // 3.校验槽位代数：不超过代数上限，达到上限的为退役槽位
+        if (std::any_of(generations, generations + header.capacity, [&](std::uint32_t generation)
+                        { return generation > max_generation_; }))
+        {
+            LOG_ERROR << "检查点恢复失败，槽位代数超过上限：" << path;
+            return false;
+        }
+
+        // 4.校验航迹记录：槽位不重复，ID与槽位代数一致，存储级别与点迹数合法，点迹总数一致
+        std::uint64_t point_total = 0;
+        std::vector<bool> occupied(header.capacity, false);
+        for (std::uint32_t i = 0; i < header.active_count; ++i)
+        {
+            std::uint32_t slot = slot_of(active_ids[i]);
+            const CheckpointTrack &track = tracks[i];
+            if (slot >= header.capacity || occupied[slot] || generations[slot] >= max_generation_ ||
+                ((generations[slot] << index_bits_) | (slot + 1)) != active_ids[i] ||
+                track.header.track_id != active_ids[i] ||
+                track.size_class >= point_pool_.class_count() ||
+                track.point_count > point_pool_.class_length(track.size_class))
+            {
+                LOG_ERROR << "检查点恢复失败，航迹记录" << active_ids[i] << "非法：" << path;
+                return false;
+            }
+            occupied[slot] = true;
+            point_total += track.point_count;
+        }
+        if (point_total != header.point_count)
+        {
+            LOG_ERROR << "检查点恢复失败，点迹总数不符：" << path;
+            return false;
+        }
+
+        // 5.校验空闲列表：槽位合法、未退役，不重复且不与活跃航迹重叠
+        for (std::uint32_t i = 0; i < header.free_count; ++i)
+        {
+            std::uint32_t slot = free_slots[i];
+            if (slot >= header.capacity || occupied[slot] || generations[slot] >= max_generation_)
+            {
+                LOG_ERROR << "检查点恢复失败，空闲列表槽位" << slot << "非法或重复：" << path;
+                return false;
+            }
+            occupied[slot] = true;
+        }
+
+        // 6.恢复会整体改写槽位代数与空闲列表，不能有读取会话；清空现有航迹，容量不足时扩容
+        if (epochs_.has_readers())
+        {
+            LOG_ERROR << "检查点恢复失败，存在未结束的读取会话：" << path;
+            return false;
+        }
+        clear_all();
+        if (header.capacity > capacity_)
+        {
+            grow_to(header.capacity);
+        }
+
+        // 7.恢复槽位代数与空闲队列；当前容量多于检查点时，多出的槽位排在队尾，最后分配
+        std::copy(generations, generations + header.capacity, slot_generations_.begin());
+        std::fill(slot_ids_.begin(), slot_ids_.end(), 0);
+        free_slots_.clear();
+        for (std::uint32_t i = 0; i < header.free_count; ++i)
+        {
+            free_slots_.push_back(free_slots[i]);
+        }
+        for (std::uint32_t slot = header.capacity; slot < capacity_; ++slot)
+        {
+            if (slot_generations_[slot] < max_generation_)
+                free_slots_.push_back(slot);
+        }
+
+        // 8.逐条重建航迹，点迹从映射区一次拷贝；最后更新时刻记为恢复时刻，重启后每条航迹重新计算静默超时
+        const std::int64_t load_ms = ingest_clock_ms();
+        const auto *points = reinterpret_cast<const TrackPoint *>(file.data() + points_offset);
+        active_ids_.assign(active_ids, active_ids + header.active_count);
+        for (std::uint32_t i = 0; i < header.active_count; ++i)
+        {
+            const CheckpointTrack &record = tracks[i];
+            std::uint32_t track_id = active_ids[i];
+            std::uint32_t slot = slot_of(track_id);
+
+            slot_ids_[slot] = track_id;
+            published_ids_[slot].store(track_id, std::memory_order_release);
+            active_pos_[slot] = i;
+            header_at(slot) = record.header;
+
+            TrackBuffer &track = buffer_at(slot);
+            track.size_class = record.size_class;
+            // clear_all已归还全部块，各级可用块数不少于容量硬上限，申请不会失败
+            track.data.rebind(point_pool_.acquire(record.size_class), point_pool_.class_length(record.size_class));
+            track.data.push_n(points, record.point_count);
+            track.last_update_ms = load_ms;
+            points += record.point_count;
+
+            journal_.mark_dirty(slot);
+            if (aging_enabled_)
+                aging_wheel_.schedule(slot, track_id);
+            if (!track.data.empty())
+            {
+                const TrackPoint &latest = track.data[track.data.size() - 1];
+                spatial_grid_.update(slot, track_id, latest.longitude, latest.latitude);
+            }
+        }
+        high_water_mark_ = std::max<size_t>(header.high_water_mark, active_ids_.size());
+
+        LOG_INFO << "检查点已恢复：" << path << "，航迹" << header.active_count << "条，点迹" << header.point_count << "个";
+        return true;
+    }
+
+} // namespace track_project::trackmanager
@@ -0,0 +1,69 @@
+/*****************************************************************************
+ * @file TrackCheckpoint.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 航迹管理器检查点文件格式
+ * 1、文件头 + 槽位代数 + 空闲列表 + 活跃ID + 航迹记录 + 点迹，各段按8字节对齐
+ * 2、点迹按航迹逻辑顺序（旧->新）连续存放，恢复时每条航迹一次拷贝，环形缓冲区下标归一
+ * 3、文件头记录版本号、结构体大小与ID编码参数，任一不符即拒绝恢复
+ * 4、整数按本机字节序存放，检查点只用于同一平台上的重启恢复
+ * @version 0.1
+ * @date 2025-12-13
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _TRACK_CHECKPOINT_HPP_
+#define _TRACK_CHECKPOINT_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include "../include/defstruct.h"
+
+namespace track_project::trackmanager
+{
+
+    // 文件标识与版本，格式变化时版本号加一
+    constexpr char CHECKPOINT_MAGIC[8] = {'T', 'R', 'K', 'C', 'K', 'P', 'T', '\0'};
+    constexpr std::uint32_t CHECKPOINT_VERSION = 3; // 2：空闲列表改为按分配顺序（先进先出）存放；3：去掉航迹ID标签字段
+
+    // 段对齐
+    constexpr size_t CHECKPOINT_ALIGNMENT = 8;
+
+    constexpr size_t checkpoint_align(size_t bytes)
+    {
+        return (bytes + CHECKPOINT_ALIGNMENT - 1) & ~(CHECKPOINT_ALIGNMENT - 1);
+    }
+
+    struct CheckpointHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t header_bytes;     // sizeof(TrackerHeader)
+        std::uint32_t point_bytes;      // sizeof(TrackPoint)
+        std::uint32_t track_length;     // 每条航迹点迹容量上限
+        std::uint32_t index_bits;       // ID编码参数，须与恢复方一致
+        std::uint32_t capacity;         // 槽位数，即代数段长度
+        std::uint32_t free_count;       // 空闲列表长度，列表按分配顺序存放
+        std::uint32_t active_count;     // 活跃航迹数，即活跃ID段与航迹记录段长度
+        std::uint64_t high_water_mark;
+        std::uint64_t point_count;      // 点迹段总点数
+    };
+
+    // 单条航迹记录，顺序与活跃ID段一致
+    struct CheckpointTrack
+    {
+        TrackerHeader header;
+        std::uint32_t size_class;
+        std::uint32_t point_count;
+    };
+
+    static_assert(std::is_trivially_copyable_v<CheckpointHeader>, "CheckpointHeader 不是平凡的");
+    static_assert(std::is_trivially_copyable_v<CheckpointTrack>, "CheckpointTrack 不是平凡的");
+    static_assert(sizeof(CheckpointHeader) % CHECKPOINT_ALIGNMENT == 0, "CheckpointHeader 未按段对齐");
+    static_assert(alignof(TrackPoint) <= CHECKPOINT_ALIGNMENT, "TrackPoint 对齐超过段对齐");
+
+} // namespace track_project::trackmanager
+
+#endif // _TRACK_CHECKPOINT_HPP_
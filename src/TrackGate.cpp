@@ -0,0 +1,135 @@
+#include "TrackGate.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+namespace track_project::trackmanager
+{
+
+    namespace
+    {
+        constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+        // 每个线程分得的任务块数，块数多于线程数以平衡各块的候选数差异
+        constexpr std::uint32_t CHUNKS_PER_THREAD = 4;
+
+        // 粗筛半径的相对舍入余量：粗筛半径按三角不等式推导，只需覆盖几次浮点运算的舍入误差
+        constexpr double ROUNDING_MARGIN = 1e-9;
+
+        // 点迹处经度每度对应的距离（米），与SpatialGrid::query_radius的投影一致
+        double meters_per_longitude(double latitude)
+        {
+            return SpatialGrid::METERS_PER_DEGREE * std::max(std::cos(latitude * DEG_TO_RAD), 1e-6);
+        }
+    }
+
+    TrackGate::TrackGate(std::uint32_t thread_count, double cell_degree)
+        : workers_(thread_count), grid_(0, cell_degree)
+    {
+    }
+
+    void TrackGate::gate(const TrackSnapshot &snapshot, const std::vector<TrackPoint> &plots, double gate_radius_m,
+                         std::vector<std::vector<std::uint32_t>> &candidates)
+    {
+        tracks_.clear();
+        for (size_t i = 0; i < snapshot.size(); ++i)
+        {
+            BufferSpan<const TrackPoint> points = snapshot.track_points(i);
+            if (!points.empty())
+                add_track(snapshot.headers[i].track_id, points[points.size() - 1]);
+        }
+        run_gate(plots, gate_radius_m, candidates);
+    }
+
+    // 航速航向按最新点迹处的投影换算为经纬度变化率，外推时不再重复计算三角函数
+    void TrackGate::add_track(std::uint32_t track_id, const TrackPoint &latest)
+    {
+        TrackState track;
+        track.longitude = latest.longitude;
+        track.latitude = latest.latitude;
+        track.longitude_rate = latest.sog * std::sin(latest.cog * DEG_TO_RAD) / meters_per_longitude(latest.latitude);
+        track.latitude_rate = latest.sog * std::cos(latest.cog * DEG_TO_RAD) / SpatialGrid::METERS_PER_DEGREE;
+        track.time_ms = latest.time.milliseconds;
+        track.track_id = track_id;
+        tracks_.push_back(track);
+    }
+
+    void TrackGate::predict(const TrackState &track, std::int64_t time_ms, double &longitude, double &latitude)
+    {
+        double dt = static_cast<double>(time_ms - track.time_ms) / 1000.0;
+        longitude = track.longitude + track.longitude_rate * dt;
+        latitude = track.latitude + track.latitude_rate * dt;
+    }
+
+    void TrackGate::run_gate(const std::vector<TrackPoint> &plots, double gate_radius_m,
+                             std::vector<std::vector<std::uint32_t>> &candidates)
+    {
+        candidates.resize(plots.size());
+        for (auto &list : candidates)
+        {
+            list.clear();
+        }
+        if (plots.empty() || tracks_.empty())
+            return;
+
+        // 1.参考时刻取本批点迹时间范围的中点，同时统计经纬度变化率上限
+        auto [min_it, max_it] = std::minmax_element(plots.begin(), plots.end(), [](const TrackPoint &a, const TrackPoint &b)
+                                                    { return a.time.milliseconds < b.time.milliseconds; });
+        const std::int64_t ref_time = min_it->time.milliseconds + (max_it->time.milliseconds - min_it->time.milliseconds) / 2;
+
+        // 预测位置之差在经纬度上分别不超过 变化率上限×时间差
+        double max_longitude_rate = 0.0, max_latitude_rate = 0.0;
+        for (const TrackState &track : tracks_)
+        {
+            max_longitude_rate = std::max(max_longitude_rate, std::abs(track.longitude_rate));
+            max_latitude_rate = std::max(max_latitude_rate, std::abs(track.latitude_rate));
+        }
+
+        // 2.外推到参考时刻建立网格，网格中的ID为tracks_下标
+        grid_.reset(static_cast<std::uint32_t>(tracks_.size()));
+        for (std::uint32_t i = 0; i < tracks_.size(); ++i)
+        {
+            double longitude, latitude;
+            predict(tracks_[i], ref_time, longitude, latitude);
+            grid_.update(i, i, longitude, latitude);
+        }
+
+        // 3.点迹按块并行筛选，网格与航迹状态只读
+        const std::uint32_t plot_count = static_cast<std::uint32_t>(plots.size());
+        const std::uint32_t chunk_count = std::min(plot_count, workers_.size() * CHUNKS_PER_THREAD);
+        const std::uint32_t chunk_size = (plot_count + chunk_count - 1) / chunk_count;
+        chunk_hits_.resize(chunk_count);
+
+        const double gate_sq = gate_radius_m * gate_radius_m;
+        workers_.run(chunk_count, [&](std::uint32_t chunk)
+                     {
+                         std::vector<std::uint32_t> &hits = chunk_hits_[chunk];
+                         const std::uint32_t begin = chunk * chunk_size;
+                         const std::uint32_t end = std::min(plot_count, begin + chunk_size);
+
+                         for (std::uint32_t p = begin; p < end; ++p)
+                         {
+                             const TrackPoint &plot = plots[p];
+                             const std::int64_t plot_time = plot.time.milliseconds;
+                             const double meters_per_lon = meters_per_longitude(plot.latitude);
+
+                             // 任一航迹参考时刻与点迹时刻的预测位置之差，在点迹处投影下的距离上限
+                             const double dt = std::abs(static_cast<double>(plot_time - ref_time)) / 1000.0;
+                             const double drift = std::hypot(max_longitude_rate * meters_per_lon, max_latitude_rate * SpatialGrid::METERS_PER_DEGREE) * dt;
+
+                             hits.clear();
+                             grid_.query_radius(plot.longitude, plot.latitude, (gate_radius_m + drift) * (1.0 + ROUNDING_MARGIN), hits);
+
+                             for (std::uint32_t index : hits)
+                             {
+                                 double longitude, latitude;
+                                 predict(tracks_[index], plot_time, longitude, latitude);
+                                 double dx = (longitude - plot.longitude) * meters_per_lon;
+                                 double dy = (latitude - plot.latitude) * SpatialGrid::METERS_PER_DEGREE;
+                                 if (dx * dx + dy * dy <= gate_sq)
+                                     candidates[p].push_back(tracks_[index].track_id);
+                             }
+                         } });
+    }
+
+} // namespace track_project::trackmanager
@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * @file TrackGate.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 点迹-航迹批量波门筛选
+ * 1、取各活跃航迹最新点迹，按航速航向外推到本批点迹的参考时刻，建立网格索引
+ * 2、外推在经纬度上对时间线性，航迹参考时刻与点迹时刻预测位置之差不超过 经纬度变化率上限×|点迹时刻-参考时刻|；
+ *    粗筛与精筛使用同一点迹处的局部等距投影，由三角不等式，粗筛半径取 波门半径 + 该差值上限 不漏掉候选
+ * 3、粗筛结果再外推到点迹自身时刻，距离不超过波门半径的航迹作为候选
+ * 4、点迹批次按块分给线程池并行处理，各块写入各自点迹的候选列表
+ * 5、其他线程经 ManagementService::gate_plots 从已发布的快照筛选，不访问正在被修改的航迹管理器
+ * @version 0.1
+ * @date 2025-12-11
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _TRACK_GATE_HPP_
+#define _TRACK_GATE_HPP_
+
+#include <vector>
+#include <cstdint>
+
+#include "../include/defstruct.h"
+#include "LatestKBuffer.hpp"
+#include "SpatialGrid.hpp"
+#include "TrackSnapshot.hpp"
+#include "WorkerPool.hpp"
+
+namespace track_project::trackmanager
+{
+
+    class TrackGate
+    {
+        using TrackPoint = track_project::TrackPoint;
+        using TrackerHeader = track_project::TrackerHeader;
+
+    public:
+        /*****************************************************************************
+         * @brief 构造波门筛选器
+         *
+         * @param thread_count 并行线程数（含调用线程）
+         * @param cell_degree 预测位置网格边长（度）
+         *****************************************************************************/
+        explicit TrackGate(std::uint32_t thread_count = 1, double cell_degree = 0.01);
+
+        // 持有线程资源，禁止拷贝，移动
+        TrackGate(const TrackGate &) = delete;
+        TrackGate &operator=(const TrackGate &) = delete;
+        TrackGate(TrackGate &&) = delete;
+        TrackGate &operator=(TrackGate &&) = delete;
+
+        ~TrackGate() = default;
+
+        /*****************************************************************************
+         * @brief 批量波门筛选，在航迹管理器的写入线程调用
+         *
+         * @tparam Manager 提供 for_each_active 的航迹管理器，如 TrackerManager
+         * @param manager 航迹管理器，筛选期间不得被修改
+         * @param plots 待关联点迹
+         * @param gate_radius_m 波门半径（米）
+         * @param candidates 输出：candidates[i] 为 plots[i] 的候选航迹ID，顺序不定
+         *****************************************************************************/
+        template <typename Manager>
+        void gate(const Manager &manager, const std::vector<TrackPoint> &plots, double gate_radius_m,
+                  std::vector<std::vector<std::uint32_t>> &candidates)
+        {
+            tracks_.clear();
+            manager.for_each_active([this](const TrackerHeader &header, const LatestKBuffer<TrackPoint> &data)
+                                    {
+                                        if (!data.empty())
+                                            add_track(header.track_id, data[data.size() - 1]);
+                                    });
+            run_gate(plots, gate_radius_m, candidates);
+        }
+
+        /*****************************************************************************
+         * @brief 按已发布的快照批量波门筛选，可在任意线程调用，快照持有期间内容不变
+         *
+         * @param snapshot 活跃航迹快照
+         * @param plots 待关联点迹
+         * @param gate_radius_m 波门半径（米）
+         * @param candidates 输出：candidates[i] 为 plots[i] 的候选航迹ID，顺序不定
+         *****************************************************************************/
+        void gate(const TrackSnapshot &snapshot, const std::vector<TrackPoint> &plots, double gate_radius_m,
+                  std::vector<std::vector<std::uint32_t>> &candidates);
+
+        // 最近一次筛选参与的航迹数
+        size_t track_count() const noexcept { return tracks_.size(); }
+
+    private:
+        // 航迹最新点迹的运动状态，外推为经纬度对时间的线性函数
+        struct TrackState
+        {
+            double longitude;
+            double latitude;
+            double longitude_rate; // 经度变化率，度/秒
+            double latitude_rate;  // 纬度变化率，度/秒
+            std::int64_t time_ms;
+            std::uint32_t track_id;
+        };
+
+        void add_track(std::uint32_t track_id, const TrackPoint &latest);
+
+        void run_gate(const std::vector<TrackPoint> &plots, double gate_radius_m,
+                      std::vector<std::vector<std::uint32_t>> &candidates);
+
+        // 将航迹外推到指定时刻
+        static void predict(const TrackState &track, std::int64_t time_ms, double &longitude, double &latitude);
+
+        WorkerPool workers_;
+        SpatialGrid grid_;
+
+        std::vector<TrackState> tracks_;
+        std::vector<std::vector<std::uint32_t>> chunk_hits_; // 每个任务块的粗筛结果暂存
+    };
+
+} // namespace track_project::trackmanager
+
+#endif // _TRACK_GATE_HPP_
@@ -0,0 +1,239 @@
+/*****************************************************************************
+ * @file TrackJournal.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 航迹变更日志，供增量消费者使用
+ * 1、每个消费者拥有独立的脏槽位列表与删除ID列表，按槽位位图去重，同一槽位在两次拉取之间只记录一次
+ * 2、创建、追加点迹、融合记为脏槽位，删除记录被删除的ID，清空记为整体失效
+ * 3、拉取时才把脏槽位解析为当前航迹ID，代价与变更数量成正比而与航迹总数无关
+ * 4、没有注册消费者时记录操作只有一次位运算比较
+ * 5、删除ID列表超过槽位总数（消费者长期不拉取）时丢弃记录并退化为整体失效，由航迹管理器在下次拉取前补全现有航迹
+ * @version 0.1
+ * @date 2025-12-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _TRACK_JOURNAL_HPP_
+#define _TRACK_JOURNAL_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace track_project::trackmanager
+{
+
+    // 一次拉取得到的变更集合，槽位可能在两次拉取之间被删除后复用，消费者应先处理删除再处理更新
+    struct TrackChanges
+    {
+        bool cleared = false;                    // 期间发生过清空（或刚注册），消费者应丢弃已有的全部航迹
+        std::vector<std::uint32_t> updated_ids;  // 新建或有变化、且当前仍存活的航迹ID
+        std::vector<std::uint32_t> deleted_ids;  // 期间被删除的航迹ID
+
+        bool empty() const noexcept { return !cleared && updated_ids.empty() && deleted_ids.empty(); }
+    };
+
+    class TrackJournal
+    {
+    public:
+        // 消费者数量上限，位图按字节存放
+        static constexpr int MAX_CONSUMERS = 8;
+
+        explicit TrackJournal(std::uint32_t slot_count) : dirty_masks_(slot_count, 0) {}
+
+        // 跟随航迹管理器，禁止拷贝，移动
+        TrackJournal(const TrackJournal &) = delete;
+        TrackJournal &operator=(const TrackJournal &) = delete;
+        TrackJournal(TrackJournal &&) = delete;
+        TrackJournal &operator=(TrackJournal &&) = delete;
+
+        ~TrackJournal() = default;
+
+        // 扩展槽位数量，已有记录不变
+        void grow(std::uint32_t slot_count)
+        {
+            if (slot_count > dirty_masks_.size())
+                dirty_masks_.resize(slot_count, 0);
+        }
+
+        /*****************************************************************************
+         * @brief 注册消费者，新消费者的第一次拉取带有cleared标记
+         * @return 消费者编号，已满返回-1
+         *****************************************************************************/
+        int register_consumer()
+        {
+            for (int c = 0; c < MAX_CONSUMERS; ++c)
+            {
+                std::uint8_t bit = std::uint8_t(1u << c);
+                if (!(consumer_mask_ & bit))
+                {
+                    consumer_mask_ |= bit;
+                    consumers_[c].cleared = true;
+                    consumers_[c].resync = false;
+                    consumers_[c].dirty_slots.clear();
+                    consumers_[c].deleted_ids.clear();
+                    return c;
+                }
+            }
+            return -1;
+        }
+
+        // 注销消费者，清除其在位图中的残留标记
+        void unregister_consumer(int consumer)
+        {
+            if (!valid(consumer))
+                return;
+            std::uint8_t bit = std::uint8_t(1u << consumer);
+            for (std::uint32_t slot : consumers_[consumer].dirty_slots)
+            {
+                dirty_masks_[slot] &= std::uint8_t(~bit);
+            }
+            consumers_[consumer].dirty_slots.clear();
+            consumers_[consumer].deleted_ids.clear();
+            consumer_mask_ &= std::uint8_t(~bit);
+        }
+
+        bool valid(int consumer) const noexcept
+        {
+            return consumer >= 0 && consumer < MAX_CONSUMERS && (consumer_mask_ & (1u << consumer));
+        }
+
+        // 标记槽位有变化：所有消费者均已标记时直接返回
+        void mark_dirty(std::uint32_t slot)
+        {
+            std::uint8_t missing = consumer_mask_ & std::uint8_t(~dirty_masks_[slot]);
+            if (!missing)
+                return;
+            for (int c = 0; c < MAX_CONSUMERS; ++c)
+            {
+                if (missing & (1u << c))
+                    consumers_[c].dirty_slots.push_back(slot);
+            }
+            dirty_masks_[slot] |= missing;
+        }
+
+        // 只为单个消费者标记槽位，用于新消费者补全现有航迹
+        void mark_dirty_for(int consumer, std::uint32_t slot)
+        {
+            std::uint8_t bit = std::uint8_t(1u << consumer);
+            if (dirty_masks_[slot] & bit)
+                return;
+            consumers_[consumer].dirty_slots.push_back(slot);
+            dirty_masks_[slot] |= bit;
+        }
+
+        // 记录被删除的航迹ID，槽位脏标记保留，拉取时发现槽位空闲即跳过；超过上限的消费者退化为整体失效
+        void mark_deleted(std::uint32_t track_id)
+        {
+            if (!consumer_mask_)
+                return;
+            for (int c = 0; c < MAX_CONSUMERS; ++c)
+            {
+                if (!(consumer_mask_ & (1u << c)) || consumers_[c].resync)
+                    continue;
+                if (consumers_[c].deleted_ids.size() >= dirty_masks_.size())
+                {
+                    resync(c);
+                    continue;
+                }
+                consumers_[c].deleted_ids.push_back(track_id);
+            }
+        }
+
+        // 丢弃消费者全部记录，下次拉取带cleared标记，调用方须先用mark_dirty_for补全现有航迹
+        void resync(int consumer)
+        {
+            if (!valid(consumer))
+                return;
+            Consumer &state = consumers_[consumer];
+            std::uint8_t bit = std::uint8_t(1u << consumer);
+            for (std::uint32_t slot : state.dirty_slots)
+            {
+                dirty_masks_[slot] &= std::uint8_t(~bit);
+            }
+            state.dirty_slots.clear();
+            state.deleted_ids.clear();
+            state.deleted_ids.shrink_to_fit();
+            state.cleared = true;
+            state.resync = true;
+        }
+
+        // 取出并清除消费者的补全标记，为true时调用方须用mark_dirty_for补全全部现有航迹后再拉取
+        bool take_resync(int consumer)
+        {
+            if (!valid(consumer) || !consumers_[consumer].resync)
+                return false;
+            consumers_[consumer].resync = false;
+            return true;
+        }
+
+        // 整体清空：丢弃全部未拉取的记录
+        void mark_cleared()
+        {
+            if (!consumer_mask_)
+                return;
+            for (int c = 0; c < MAX_CONSUMERS; ++c)
+            {
+                if (!(consumer_mask_ & (1u << c)))
+                    continue;
+                for (std::uint32_t slot : consumers_[c].dirty_slots)
+                {
+                    dirty_masks_[slot] = 0;
+                }
+                consumers_[c].dirty_slots.clear();
+                consumers_[c].deleted_ids.clear();
+                consumers_[c].cleared = true;
+                consumers_[c].resync = false;
+            }
+        }
+
+        /*****************************************************************************
+         * @brief 拉取并清空消费者的记录
+         *
+         * @param resolve 可调用对象，签名 std::uint32_t(std::uint32_t slot)，返回槽位当前航迹ID，空闲返回0
+         *****************************************************************************/
+        template <typename Resolve>
+        void poll(int consumer, TrackChanges &changes, Resolve &&resolve)
+        {
+            changes.cleared = false;
+            changes.updated_ids.clear();
+            changes.deleted_ids.clear();
+            if (!valid(consumer))
+                return;
+
+            Consumer &state = consumers_[consumer];
+            std::uint8_t bit = std::uint8_t(1u << consumer);
+
+            changes.cleared = state.cleared;
+            changes.deleted_ids.swap(state.deleted_ids);
+            changes.updated_ids.reserve(state.dirty_slots.size());
+            for (std::uint32_t slot : state.dirty_slots)
+            {
+                dirty_masks_[slot] &= std::uint8_t(~bit);
+                std::uint32_t track_id = resolve(slot);
+                if (track_id != 0)
+                    changes.updated_ids.push_back(track_id);
+            }
+
+            state.dirty_slots.clear();
+            state.deleted_ids.clear();
+            state.cleared = false;
+        }
+
+    private:
+        struct Consumer
+        {
+            bool cleared = false;
+            bool resync = false; // 删除记录溢出后需要补全现有航迹
+            std::vector<std::uint32_t> dirty_slots;
+            std::vector<std::uint32_t> deleted_ids;
+        };
+
+        std::vector<std::uint8_t> dirty_masks_; // 槽位 -> 已记录该槽位的消费者位图
+        Consumer consumers_[MAX_CONSUMERS];
+        std::uint8_t consumer_mask_ = 0; // 已注册消费者位图
+    };
+
+} // namespace track_project::trackmanager
+
+#endif // _TRACK_JOURNAL_HPP_
@@ -0,0 +1,87 @@
+#include "TrackPointPool.hpp"
+#include "../utils/Logger.hpp"
+
+#include <algorithm>
+
+namespace track_project::trackmanager
+{
+
+    // 构造函数：生成级别表，每级只预留虚拟地址，不产生常驻内存
+    TrackPointPool::TrackPointPool(std::uint32_t block_count, std::uint32_t max_length, bool use_huge_pages)
+        : block_count_(block_count)
+    {
+        assert(block_count > 0 && max_length > 0 && "申请了过小的内存！");
+
+        std::uint32_t length = std::min(MIN_CLASS_LENGTH, max_length);
+        while (true)
+        {
+            SizeClass size_class;
+            size_class.length = length;
+            size_class.in_use = 0;
+            size_class.arena = std::make_unique<TrackArena>(TrackArena::bytes_for<TrackPoint>(length) * block_count, use_huge_pages);
+            size_class.free_list.reserve(block_count);
+            classes_.push_back(std::move(size_class));
+
+            if (length >= max_length)
+                break;
+            length = (length > max_length / CLASS_GROWTH) ? max_length : length * CLASS_GROWTH;
+        }
+    }
+
+    // 优先复用空闲链表，否则从该级存储区切分新块
+    TrackPointPool::TrackPoint *TrackPointPool::acquire(std::uint32_t size_class)
+    {
+        SizeClass &cls = classes_[size_class];
+
+        TrackPoint *block;
+        if (!cls.free_list.empty())
+        {
+            block = cls.free_list.back();
+            cls.free_list.pop_back();
+        }
+        else
+        {
+            block = cls.in_use < block_count_ ? cls.arena->carve<TrackPoint>(cls.length) : nullptr;
+            if (!block)
+                return nullptr;
+        }
+
+        cls.in_use++;
+        return block;
+    }
+
+    void TrackPointPool::release(TrackPoint *block, std::uint32_t size_class)
+    {
+        if (!block)
+            return;
+
+        SizeClass &cls = classes_[size_class];
+        cls.free_list.push_back(block);
+        cls.in_use--;
+    }
+
+    size_t TrackPointPool::trim() noexcept
+    {
+        size_t bytes = 0;
+        for (auto &cls : classes_)
+        {
+            const size_t block_bytes = TrackArena::bytes_for<TrackPoint>(cls.length);
+            for (TrackPoint *block : cls.free_list)
+            {
+                bytes += cls.arena->discard(block, block_bytes);
+            }
+        }
+        return bytes;
+    }
+
+    size_t TrackPointPool::used_bytes() const noexcept
+    {
+        size_t bytes = 0;
+        for (const auto &cls : classes_)
+        {
+            bytes += TrackArena::bytes_for<TrackPoint>(cls.length) * cls.in_use;
+        }
+        return bytes;
+    }
+
+} // namespace track_project::trackmanager
@@ -0,0 +1,95 @@
+/*****************************************************************************
+ * @file TrackPointPool.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 分级点迹存储池
+ * 1、按长度分为若干级（32、128、512...直到航迹长度上限），每级一块独立的TrackArena
+ * 2、每级预留 block_count 个块的虚拟地址，块按需切分，释放后进入该级空闲链表复用
+ * 3、新航迹从最小级开始，写满后由航迹管理器搬迁到下一级，常驻内存随实际点迹数增长
+ * @version 0.1
+ * @date 2025-12-09
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _TRACK_POINT_POOL_HPP_
+#define _TRACK_POINT_POOL_HPP_
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "../include/defstruct.h"
+#include "TrackArena.hpp"
+
+namespace track_project::trackmanager
+{
+
+    class TrackPointPool
+    {
+        using TrackPoint = track_project::TrackPoint;
+
+    public:
+        // 最小一级的点迹容量，与航迹起始4点相比留有余量
+        static constexpr std::uint32_t MIN_CLASS_LENGTH = 32;
+        // 相邻两级之间的容量倍数
+        static constexpr std::uint32_t CLASS_GROWTH = 4;
+
+        /*****************************************************************************
+         * @brief 构造分级存储池
+         *
+         * @param block_count 每一级最多同时使用的块数（即航迹容量上限）
+         * @param max_length 最高一级的点迹容量（即航迹长度上限）
+         * @param use_huge_pages 是否尝试使用大页
+         *****************************************************************************/
+        TrackPointPool(std::uint32_t block_count, std::uint32_t max_length, bool use_huge_pages = false);
+
+        // 独占存储区，禁止拷贝，移动
+        TrackPointPool(const TrackPointPool &) = delete;
+        TrackPointPool &operator=(const TrackPointPool &) = delete;
+        TrackPointPool(TrackPointPool &&) = delete;
+        TrackPointPool &operator=(TrackPointPool &&) = delete;
+
+        ~TrackPointPool() = default;
+
+        /*****************************************************************************
+         * @brief 从指定级别申请一个块
+         * @return 块首地址，可容纳 class_length(size_class) 个点迹；该级已有block_count个块在用时返回nullptr
+         *****************************************************************************/
+        TrackPoint *acquire(std::uint32_t size_class);
+
+        /*****************************************************************************
+         * @brief 归还块到指定级别的空闲链表
+         *****************************************************************************/
+        void release(TrackPoint *block, std::uint32_t size_class);
+
+        /*****************************************************************************
+         * @brief 将空闲链表中各块的物理页归还操作系统，块仍可复用
+         * @return 归还的字节数（小于一页的块不参与）
+         *****************************************************************************/
+        size_t trim() noexcept;
+
+        // 级别信息
+        std::uint32_t class_count() const noexcept { return static_cast<std::uint32_t>(classes_.size()); }
+        std::uint32_t class_length(std::uint32_t size_class) const noexcept { return classes_[size_class].length; }
+        bool is_top_class(std::uint32_t size_class) const noexcept { return size_class + 1 >= classes_.size(); }
+
+        // 统计信息：当前被航迹占用的点迹存储字节数
+        size_t used_bytes() const noexcept;
+        std::uint32_t in_use(std::uint32_t size_class) const noexcept { return classes_[size_class].in_use; }
+
+    private:
+        struct SizeClass
+        {
+            std::uint32_t length;                // 每块点迹容量
+            std::uint32_t in_use;                // 正在使用的块数
+            std::unique_ptr<TrackArena> arena;   // 该级的存储区
+            std::vector<TrackPoint *> free_list; // 已释放待复用的块，后进先出保证缓存热度
+        };
+
+        std::vector<SizeClass> classes_;
+        std::uint32_t block_count_;
+    };
+
+} // namespace track_project::trackmanager
+
+#endif // _TRACK_POINT_POOL_HPP_
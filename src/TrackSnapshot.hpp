@@ -0,0 +1,269 @@
+/*****************************************************************************
+ * @file TrackSnapshot.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 活跃航迹快照的三缓冲发布
+ * 1、快照包含全部活跃航迹的航迹头与各自最新N个点迹，发布后不再修改
+ * 2、三个快照预先分配并循环复用，每个缓冲区在变更日志中各占一个消费者，构建时只拷贝自身上次构建以来变化的航迹
+ * 3、发布为一次原子交换；读取方一次原子加法取得最新快照并登记引用，释放为一次原子减法，双方均无等待
+ * 4、两个备用缓冲区都仍被读取方持有时跳过本次发布，写入方从不等待读取方
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _TRACK_SNAPSHOT_HPP_
+#define _TRACK_SNAPSHOT_HPP_
+
+#include <atomic>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "../include/defstruct.h"
+#include "LatestKBuffer.hpp"
+#include "TrackJournal.hpp"
+
+namespace track_project::trackmanager
+{
+
+    // 不可变的活跃航迹快照
+    struct TrackSnapshot
+    {
+        std::uint64_t sequence = 0;        // 发布序号，从1开始，0表示尚未发布
+        std::int64_t publish_time_ms = 0;  // 发布时刻
+        std::uint32_t points_per_track = 0; // 每条航迹保留的点迹数N
+
+        std::vector<TrackerHeader> headers;      // 航迹头，顺序不定
+        std::vector<std::uint32_t> point_counts; // 各航迹有效点迹数，不超过N
+        std::vector<TrackPoint> points;          // 每条航迹占N个位置，旧->新，前point_counts[i]个有效
+
+        size_t size() const noexcept { return headers.size(); }
+
+        // 第index条航迹的有效点迹
+        BufferSpan<const TrackPoint> track_points(size_t index) const noexcept
+        {
+            return BufferSpan<const TrackPoint>(points.data() + index * points_per_track, point_counts[index]);
+        }
+    };
+
+    class TrackSnapshotPublisher
+    {
+        using TrackPoint = track_project::TrackPoint;
+        using TrackerHeader = track_project::TrackerHeader;
+
+    public:
+        static constexpr std::uint32_t BUFFER_COUNT = 3;
+
+        /*****************************************************************************
+         * @brief 读取方持有的快照引用，析构时释放
+         *****************************************************************************/
+        class Handle
+        {
+        public:
+            Handle(Handle &&other) noexcept : publisher_(other.publisher_), index_(other.index_)
+            {
+                other.publisher_ = nullptr;
+            }
+
+            Handle(const Handle &) = delete;
+            Handle &operator=(const Handle &) = delete;
+            Handle &operator=(Handle &&) = delete;
+
+            ~Handle()
+            {
+                if (publisher_)
+                    publisher_->buffers_[index_].references.fetch_sub(1, std::memory_order_release);
+            }
+
+            const TrackSnapshot &operator*() const noexcept { return publisher_->buffers_[index_].snapshot; }
+            const TrackSnapshot *operator->() const noexcept { return &publisher_->buffers_[index_].snapshot; }
+
+        private:
+            friend class TrackSnapshotPublisher;
+
+            Handle(const TrackSnapshotPublisher *publisher, std::uint32_t index) : publisher_(publisher), index_(index) {}
+
+            const TrackSnapshotPublisher *publisher_;
+            std::uint32_t index_;
+        };
+
+        /*****************************************************************************
+         * @brief 构造发布器
+         *
+         * @param points_per_track 每条航迹保留的最新点迹数N
+         *****************************************************************************/
+        explicit TrackSnapshotPublisher(std::uint32_t points_per_track)
+        {
+            for (auto &buffer : buffers_)
+            {
+                buffer.snapshot.points_per_track = points_per_track;
+            }
+        }
+
+        // 多线程共享，禁止拷贝，移动
+        TrackSnapshotPublisher(const TrackSnapshotPublisher &) = delete;
+        TrackSnapshotPublisher &operator=(const TrackSnapshotPublisher &) = delete;
+        TrackSnapshotPublisher(TrackSnapshotPublisher &&) = delete;
+        TrackSnapshotPublisher &operator=(TrackSnapshotPublisher &&) = delete;
+
+        ~TrackSnapshotPublisher() = default;
+
+        /*****************************************************************************
+         * @brief 读取方：取得最新发布的快照，可在任意线程调用，无等待
+         *****************************************************************************/
+        Handle acquire() const
+        {
+            std::uint64_t state = state_.fetch_add(READER_ONE, std::memory_order_acquire);
+            return Handle(this, static_cast<std::uint32_t>(state & INDEX_MASK));
+        }
+
+        /*****************************************************************************
+         * @brief 写入方：在一个空闲缓冲区上增量构建快照并发布，只能在航迹管理器的写入线程调用
+         *
+         * @tparam Manager 提供变更日志与只读引用接口的航迹管理器，如 TrackerManager
+         * @param time_ms 发布时刻
+         * @return bool 两个备用缓冲区均被读取方持有时跳过发布，返回false
+         *****************************************************************************/
+        template <typename Manager>
+        bool publish(Manager &manager, std::int64_t time_ms)
+        {
+            // 1.选择未被读取方持有的备用缓冲区
+            const std::uint32_t current = static_cast<std::uint32_t>(state_.load(std::memory_order_relaxed) & INDEX_MASK);
+            std::uint32_t target = BUFFER_COUNT;
+            for (std::uint32_t i = 1; i < BUFFER_COUNT && target == BUFFER_COUNT; ++i)
+            {
+                std::uint32_t candidate = (current + i) % BUFFER_COUNT;
+                if (buffers_[candidate].references.load(std::memory_order_acquire) == 0)
+                    target = candidate;
+            }
+            if (target == BUFFER_COUNT)
+            {
+                skipped_++;
+                return false;
+            }
+
+            // 2.拉取该缓冲区上次构建以来的变更并应用
+            Buffer &buffer = buffers_[target];
+            if (buffer.consumer < 0)
+            {
+                buffer.consumer = manager.register_change_consumer();
+                if (buffer.consumer < 0)
+                    return false;
+            }
+            manager.poll_changes(buffer.consumer, changes_);
+            if (changes_.cleared)
+            {
+                clear(buffer);
+            }
+            for (std::uint32_t track_id : changes_.deleted_ids)
+            {
+                remove(buffer, track_id);
+            }
+            for (std::uint32_t track_id : changes_.updated_ids)
+            {
+                const TrackerHeader *header = manager.get_header_ref(track_id);
+                const LatestKBuffer<TrackPoint> *data = manager.get_data_ref(track_id);
+                if (header && data)
+                    update(buffer, *header, *data);
+            }
+
+            // 3.发布：交换当前索引并清零读取计数，旧缓冲区的读取计数转入其引用计数
+            buffer.snapshot.sequence = ++sequence_;
+            buffer.snapshot.publish_time_ms = time_ms;
+            std::uint64_t old_state = state_.exchange(target, std::memory_order_acq_rel);
+            buffers_[old_state & INDEX_MASK].references.fetch_add(static_cast<std::int64_t>(old_state >> READER_SHIFT),
+                                                                  std::memory_order_release);
+            return true;
+        }
+
+        // 因备用缓冲区均被持有而跳过的发布次数
+        std::uint64_t skipped_count() const noexcept { return skipped_; }
+
+    private:
+        // state_低2位为当前快照下标，其余位为取得当前快照的读取方累计数
+        static constexpr std::uint64_t INDEX_MASK = 3;
+        static constexpr std::uint32_t READER_SHIFT = 2;
+        static constexpr std::uint64_t READER_ONE = std::uint64_t(1) << READER_SHIFT;
+
+        struct Buffer
+        {
+            TrackSnapshot snapshot;
+            std::unordered_map<std::uint32_t, std::uint32_t> positions; // 航迹ID -> 快照中的位置
+            int consumer = -1;                                          // 变更日志消费者编号
+
+            // 非当前快照的未释放引用数；成为非当前时由写入方补上当时的读取方累计数，释放可先于补记而暂时为负
+            std::atomic<std::int64_t> references{0};
+        };
+
+        void clear(Buffer &buffer)
+        {
+            buffer.snapshot.headers.clear();
+            buffer.snapshot.point_counts.clear();
+            buffer.snapshot.points.clear();
+            buffer.positions.clear();
+        }
+
+        // 交换删除：末尾航迹填补空位
+        void remove(Buffer &buffer, std::uint32_t track_id)
+        {
+            auto it = buffer.positions.find(track_id);
+            if (it == buffer.positions.end())
+                return;
+
+            TrackSnapshot &snapshot = buffer.snapshot;
+            const std::uint32_t pos = it->second;
+            const std::uint32_t last = static_cast<std::uint32_t>(snapshot.headers.size() - 1);
+            const size_t n = snapshot.points_per_track;
+            if (pos != last)
+            {
+                snapshot.headers[pos] = snapshot.headers[last];
+                snapshot.point_counts[pos] = snapshot.point_counts[last];
+                std::memcpy(&snapshot.points[pos * n], &snapshot.points[last * n], n * sizeof(TrackPoint));
+                buffer.positions[snapshot.headers[pos].track_id] = pos;
+            }
+            snapshot.headers.pop_back();
+            snapshot.point_counts.pop_back();
+            snapshot.points.resize(last * n);
+            buffer.positions.erase(it);
+        }
+
+        // 新航迹追加到末尾，已有航迹原位覆盖，只拷贝最新N个点迹
+        void update(Buffer &buffer, const TrackerHeader &header, const LatestKBuffer<TrackPoint> &data)
+        {
+            TrackSnapshot &snapshot = buffer.snapshot;
+            const size_t n = snapshot.points_per_track;
+
+            auto [it, inserted] = buffer.positions.try_emplace(header.track_id, static_cast<std::uint32_t>(snapshot.headers.size()));
+            const std::uint32_t pos = it->second;
+            if (inserted)
+            {
+                snapshot.headers.push_back(header);
+                snapshot.point_counts.push_back(0);
+                snapshot.points.resize((pos + 1) * n);
+            }
+
+            const size_t count = std::min(n, data.size());
+            const size_t first = data.size() - count;
+            TrackPoint *dest = &snapshot.points[pos * n];
+            for (size_t i = 0; i < count; ++i)
+            {
+                dest[i] = data[first + i];
+            }
+            snapshot.headers[pos] = header;
+            snapshot.point_counts[pos] = static_cast<std::uint32_t>(count);
+        }
+
+        mutable Buffer buffers_[BUFFER_COUNT];
+        alignas(64) mutable std::atomic<std::uint64_t> state_{0};
+
+        TrackChanges changes_;
+        std::uint64_t sequence_ = 0;
+        std::uint64_t skipped_ = 0;
+    };
+
+} // namespace track_project::trackmanager
+
+#endif // _TRACK_SNAPSHOT_HPP_
@@ -1,51 +1,142 @@
 #include "TrackerManager.hpp"
 #include "../utils/Logger.hpp"
 
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+
 namespace track_project::trackmanager
 {
 
-    // 定义最大外推次数,当>MAX_EXTRAPOLATION_TIMES时，终结对应航迹
-    constexpr std::uint32_t MAX_EXTRAPOLATION_TIMES = 3;
+    // 批量写入时的预取距离（条）
+    constexpr size_t PREFETCH_DISTANCE = 8;
+
+    // 读取方连续重试该次数后让出CPU
+    constexpr std::uint32_t READ_SPIN_LIMIT = 64;
+
+// ThreadSanitizer构建中，序号锁读取的普通拷贝不登记为读取，见read_track注释
+#if defined(__SANITIZE_THREAD__)
+    extern "C" void AnnotateIgnoreReadsBegin(const char *file, int line);
+    extern "C" void AnnotateIgnoreReadsEnd(const char *file, int line);
+#define SEQLOCK_READ_BEGIN() AnnotateIgnoreReadsBegin(__FILE__, __LINE__)
+#define SEQLOCK_READ_END() AnnotateIgnoreReadsEnd(__FILE__, __LINE__)
+#else
+#define SEQLOCK_READ_BEGIN() ((void)0)
+#define SEQLOCK_READ_END() ((void)0)
+#endif
 
     // 构造函数：预开辟空间，空间上构造目标
-    TrackerManager::TrackerManager(std::uint32_t track_size, std::uint32_t track_length) : next_track_id_(1), track_length(track_length)
+    TrackerManager::TrackerManager(std::uint32_t track_size, std::uint32_t track_length, bool use_huge_pages,
+                                   std::uint32_t track_ceiling)
+        : point_pool_(std::max(track_size, track_ceiling), track_length, use_huge_pages),
+          spatial_grid_(track_size),
+          journal_(track_size),
+          aging_wheel_(Timestamp::now().milliseconds),
+          capacity_(0),
+          initial_capacity_(track_size),
+          track_ceiling_(std::max(track_size, track_ceiling)),
+          track_length(track_length)
+    {
+        // ID位宽划分：槽位号+1最大为容量硬上限，其余高位用于代数
+        index_bits_ = 1;
+        while (index_bits_ < 31 && (std::uint32_t(1) << index_bits_) <= track_ceiling_)
+        {
+            index_bits_++;
+        }
+        index_mask_ = (std::uint32_t(1) << index_bits_) - 1;
+        max_generation_ = (UINT32_MAX >> index_bits_);
+
+        // 预分配初始容量，提高性能；点迹存储在创建航迹时按最小级别申请
+        header_chunks_.reserve((track_ceiling_ + SLOT_CHUNK_MASK) >> SLOT_CHUNK_BITS);
+        buffer_chunks_.reserve((track_ceiling_ + SLOT_CHUNK_MASK) >> SLOT_CHUNK_BITS);
+        active_ids_.reserve(track_size);
+        published_ids_ = std::make_unique<std::atomic<std::uint32_t>[]>(track_ceiling_);
+        grow_to(track_size);
+    }
+
+    // 扩容：只追加新块（优先复用收缩后尚未释放的块），不搬迁已有航迹头与缓冲区
+    void TrackerManager::grow_to(std::uint32_t new_capacity)
     {
+        assert(new_capacity > capacity_ && new_capacity <= track_ceiling_ && "扩容范围错误！");
 
-        // 预分配内存，提高性能
-        buffer_pool_.reserve(track_size);
-        track_id_to_pool_index_.reserve(track_size); // rehash会给creat任务带来约一倍延时
-        free_slots_.reserve(track_size);
+        std::uint32_t chunk_count = (new_capacity + SLOT_CHUNK_MASK) >> SLOT_CHUNK_BITS;
+        while (header_chunks_.size() < chunk_count)
+        {
+            header_chunks_.push_back(std::make_unique<TrackerHeader[]>(SLOT_CHUNK_SIZE));
+            buffer_chunks_.push_back(std::make_unique<TrackBuffer[]>(SLOT_CHUNK_SIZE));
+        }
 
-        // 初始化内存池
-        for (std::uint32_t i = 0; i < track_size; ++i)
+        slot_ids_.resize(new_capacity, 0);
+        active_pos_.resize(new_capacity, 0);
+        if (slot_generations_.size() < new_capacity)
         {
-            buffer_pool_.push_back(TrackerContainer(track_length));
-            free_slots_.push_back(i);
+            slot_generations_.resize(new_capacity, 0);
         }
+        spatial_grid_.grow(new_capacity);
+        journal_.grow(new_capacity);
+
+        // 新槽位按序排到队尾，低槽位先被分配，退役槽位不再加入
+        free_slots_.reserve(new_capacity);
+        for (std::uint32_t slot = capacity_; slot < new_capacity; ++slot)
+        {
+            if (slot_generations_[slot] < max_generation_)
+            {
+                free_slots_.push_back(slot);
+            }
+        }
+        capacity_ = new_capacity;
     }
 
     // 申请新航迹存储器，申请一个最新的空闲内存池，更新ID编号
     std::uint32_t TrackerManager::create_track()
     {
 
-        if (free_slots_.empty())
+        // 空闲槽位用尽时按块扩容，直到容量硬上限；删除的槽位立即回到空闲队列，不受读取会话影响
+        while (free_slots_.empty())
         {
-            LOG_DEBUG << "无法申请新航迹，已不具备新航迹";
-            return 0; // 内存池已满
+            if (capacity_ >= track_ceiling_)
+            {
+                LOG_DEBUG << "无法申请新航迹，已达到容量上限" << track_ceiling_;
+                return 0; // 内存池已满
+            }
+            std::uint32_t new_capacity = std::min(track_ceiling_, (capacity_ + SLOT_CHUNK_SIZE) & ~SLOT_CHUNK_MASK);
+            LOG_INFO << "航迹内存池扩容：" << capacity_ << " -> " << new_capacity;
+            grow_to(new_capacity);
         }
 
-        std::uint32_t pool_index = free_slots_.back();
-        free_slots_.pop_back();
-
-        // 修改索引
-        std::uint32_t track_id = next_track_id_;
-        track_id_to_pool_index_[track_id] = pool_index;
+        // 先申请最小级别的点迹存储，失败时槽位保持空闲
+        TrackPoint *block = point_pool_.acquire(0);
+        if (!block)
+        {
+            LOG_ERROR << "无法申请新航迹，点迹存储池最小级别已用尽";
+            return 0;
+        }
 
-        // 修改container属性
-        buffer_pool_[pool_index].header.start(next_track_id_);
+        std::uint32_t pool_index = free_slots_.front();
+        free_slots_.pop_front();
 
-        // 修改计数器
-        next_track_id_++;
+        // 修改索引
+        std::uint32_t track_id = make_track_id(pool_index);
+        slot_ids_[pool_index] = track_id;
+
+        // 修改container属性，从最小级别申请点迹存储；槽位可能刚被删除，仍在读取旧航迹的读取方据序号重试
+        TrackBuffer &track = buffer_at(pool_index);
+        begin_write(pool_index);
+        track.size_class = 0;
+        track.data.rebind(block, point_pool_.class_length(0));
+        track.last_update_ms = ingest_clock_ms();
+        header_at(pool_index).start(track_id);
+        end_write(pool_index);
+        published_ids_[pool_index].store(track_id, std::memory_order_release);
+
+        // 加入活跃数组
+        active_pos_[pool_index] = static_cast<std::uint32_t>(active_ids_.size());
+        active_ids_.push_back(track_id);
+        high_water_mark_ = std::max(high_water_mark_, active_ids_.size());
+        journal_.mark_dirty(pool_index);
+        if (aging_enabled_)
+            aging_wheel_.schedule(pool_index, track_id);
+        publish_event(TrackEventType::CREATED, track_id, 0, 0, nullptr);
 
         return track_id;
     }
@@ -54,23 +145,27 @@ namespace track_project::trackmanager
     bool TrackerManager::delete_track(std::uint32_t track_id)
     {
 
-        auto it = track_id_to_pool_index_.find(track_id);
+        std::uint32_t pool_index = resolve_slot(track_id);
 
         // 异常处理
-        if (it == track_id_to_pool_index_.end())
+        if (pool_index == INVALID_SLOT)
         {
             LOG_DEBUG << "删除航迹失败，该航迹号" << track_id << "不存在";
             return false; // 航迹不存在
         }
 
-        std::uint32_t pool_index = it->second;
-
-        // 清空对应的缓冲区
-        buffer_pool_[pool_index].clear();
+        // 发布删除事件，携带删除前的状态与最新点迹
+        if (event_queue_)
+        {
+            const TrackBuffer &track = buffer_at(pool_index);
+            publish_event(TrackEventType::DELETED, track_id, 0, header_at(pool_index).state,
+                          track.data.empty() ? nullptr : &track.data[track.data.size() - 1]);
+        }
 
-        // 释放资源，放到空内存区中
-        track_id_to_pool_index_.erase(it);
-        free_slots_.push_back(pool_index);
+        // 摘除航迹，槽位立即回到空闲队列
+        journal_.mark_deleted(track_id);
+        unlink_slot(pool_index);
+        release_slot(pool_index);
 
         return true;
     }
@@ -79,90 +174,184 @@ namespace track_project::trackmanager
     bool TrackerManager::push_track_point(std::uint32_t track_id, TrackPoint point)
     {
         // 搜索目标航迹
-        auto it = track_id_to_pool_index_.find(track_id);
+        std::uint32_t pool_index = resolve_slot(track_id);
 
         // 异常处理
-        if (it == track_id_to_pool_index_.end())
+        if (pool_index == INVALID_SLOT)
         {
             LOG_DEBUG << "添加航迹点失败，该航迹号" << track_id << "不存在";
             return false; // 航迹不存在
         }
 
+        return apply_point(pool_index, point, ingest_clock_ms());
+    }
+
+    // 批量存放点迹：先解析全部ID，再带预取地按批次顺序执行状态机
+    size_t TrackerManager::push_track_points(const std::vector<std::pair<TrackerHeader, TrackPoint>> &batch,
+                                             std::vector<std::uint32_t> &terminated_ids)
+    {
+        terminated_ids.clear();
+        batch_slots_.resize(batch.size());
+
+        // 1.解析ID，不存在的航迹直接记入终结列表；与前一条同一航迹时沿用其结果
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            if (i > 0 && batch[i].first.track_id == batch[i - 1].first.track_id)
+            {
+                batch_slots_[i] = batch_slots_[i - 1];
+                continue;
+            }
+            batch_slots_[i] = resolve_slot(batch[i].first.track_id);
+            if (batch_slots_[i] == INVALID_SLOT)
+            {
+                terminated_ids.push_back(batch[i].first.track_id);
+            }
+        }
+
+        // 2.两级预取：远处预取航迹头与缓冲区对象，近处预取缓冲区写入位置
+        const std::int64_t now_ms = ingest_clock_ms();
+        const size_t count = batch.size();
+        size_t applied = 0;
+        for (size_t k = 0; k < count; ++k)
+        {
+            if (k + 2 * PREFETCH_DISTANCE < count && batch_slots_[k + 2 * PREFETCH_DISTANCE] != INVALID_SLOT)
+            {
+                std::uint32_t slot = batch_slots_[k + 2 * PREFETCH_DISTANCE];
+                __builtin_prefetch(&header_at(slot), 1);
+                __builtin_prefetch(&buffer_at(slot), 0);
+            }
+            if (k + PREFETCH_DISTANCE < count && batch_slots_[k + PREFETCH_DISTANCE] != INVALID_SLOT)
+            {
+                __builtin_prefetch(buffer_at(batch_slots_[k + PREFETCH_DISTANCE]).data.write_position(), 1);
+            }
+
+            std::uint32_t pool_index = batch_slots_[k];
+            const auto &item = batch[k];
+
+            // 同批次内已终结的航迹，后续点迹直接跳过
+            if (pool_index == INVALID_SLOT || slot_ids_[pool_index] != item.first.track_id)
+                continue;
+
+            if (apply_point(pool_index, item.second, now_ms))
+            {
+                applied++;
+            }
+            else
+            {
+                terminated_ids.push_back(item.first.track_id);
+            }
+        }
+
+        // 3.压缩终结列表，同一ID只保留一次
+        std::sort(terminated_ids.begin(), terminated_ids.end());
+        terminated_ids.erase(std::unique(terminated_ids.begin(), terminated_ids.end()), terminated_ids.end());
+
+        return applied;
+    }
+
+    // 单点状态机：写入点迹并更新航迹头，航迹终结时删除并返回false
+    bool TrackerManager::apply_point(std::uint32_t pool_index, const TrackPoint &point, std::int64_t now_ms)
+    {
         // 获取航迹
-        std::uint32_t pool_index = it->second;
-        TrackerContainer &track = buffer_pool_[pool_index];
+        TrackerHeader &header = header_at(pool_index);
+        TrackBuffer &track = buffer_at(pool_index);
 
-        // 存入数据
+        // 存入数据，当前级别写满时先搬迁到下一级
+        begin_write(pool_index);
+        if (track.data.full() && !point_pool_.is_top_class(track.size_class))
+        {
+            promote_track(pool_index); // 下一级用尽时留在当前级别，覆盖最旧点迹
+        }
         track.data.push(point);
+        track.last_update_ms = now_ms;
 
         // 若航迹外推次数过多或是置信度过低，请求删除航迹
-        if (track.header.state == 2)
+        if (header.state == 2)
         {
-            TrackerManager::delete_track(track.header.track_id);
+            end_write(pool_index);
+            TrackerManager::delete_track(header.track_id);
             return false;
         }
 
         // 数据处理
-        track.header.point_num = static_cast<std::uint32_t>(track.data.size()); // 更新点迹数量
-        if (point.is_associated)                                                // 关联点继续
+        const int old_state = header.state;
+        header.point_num = static_cast<std::uint32_t>(track.data.size()); // 更新点迹数量
+        if (point.is_associated)                                          // 关联点继续
         {
-            if (track.header.extrapolation_count > 0)
+            if (header.extrapolation_count > 0)
             {
-                track.header.extrapolation_count--;
+                header.extrapolation_count--;
             }
-            track.header.state = 0;
+            header.state = 0;
         }
-        else if (track.header.extrapolation_count < MAX_EXTRAPOLATION_TIMES) // 未超过最大关联次数
+        else if (header.extrapolation_count < MAX_EXTRAPOLATION_TIMES) // 未超过最大关联次数
         {
-            track.header.extrapolation_count++;
-            track.header.state = 1;
+            header.extrapolation_count++;
+            header.state = 1;
         }
         else // 恰好超过最大外推次数
         {
-            track.header.state = 2;
+            header.state = 2;
+        }
+        end_write(pool_index);
+
+        // 同步索引、变更日志与事件
+        spatial_grid_.update(pool_index, header.track_id, point.longitude, point.latitude);
+        journal_.mark_dirty(pool_index);
+        if (header.state != old_state)
+        {
+            publish_event(TrackEventType::STATE_CHANGED, header.track_id, 0, header.state, &point);
         }
 
         return true;
     }
 
-    // 将source源航迹数据追加到target目标航迹，然后交换ID，最后删除源航迹对应的内存池
+    // 将source源航迹数据追加到target目标航迹，源航迹接管目标航迹的数据，最后删除目标航迹
     bool TrackerManager::merge_tracks(std::uint32_t source_track_id, std::uint32_t target_track_id)
     {
         // 搜索目标航迹
-        auto target_it = track_id_to_pool_index_.find(target_track_id);
-        auto source_it = track_id_to_pool_index_.find(source_track_id);
+        std::uint32_t target_pool_index = resolve_slot(target_track_id);
+        std::uint32_t source_pool_index = resolve_slot(source_track_id);
 
         // 异常处理
-        if (target_it == track_id_to_pool_index_.end() || source_it == track_id_to_pool_index_.end())
+        if (target_pool_index == INVALID_SLOT || source_pool_index == INVALID_SLOT || target_pool_index == source_pool_index)
         {
-            LOG_DEBUG << "航迹融合失败，源航迹" << source_track_id << "不存在";
+            LOG_DEBUG << "航迹融合失败，源航迹" << source_track_id << "或目标航迹" << target_track_id << "不存在";
             return false; // 航迹不存在
         }
 
         // 获取航迹
-        std::uint32_t target_pool_index = target_it->second;
-        TrackerContainer &target_track = buffer_pool_[target_pool_index];
-        std::uint32_t source_pool_index = source_it->second;
-        TrackerContainer &source_track = buffer_pool_[source_pool_index];
+        TrackBuffer &target_track = buffer_at(target_pool_index);
+        TrackBuffer &source_track = buffer_at(source_pool_index);
 
         // 异常处理
         std::uint32_t target_size = static_cast<std::uint32_t>(target_track.data.size());
         std::uint32_t source_size = static_cast<std::uint32_t>(source_track.data.size());
         if (target_size < MAX_EXTRAPOLATION_TIMES || source_size < MAX_EXTRAPOLATION_TIMES)
         {
-            LOG_DEBUG << "航迹融合失败，目标航迹" << source_track_id << "不存在";
+            LOG_DEBUG << "航迹融合失败，航迹点数不足" << MAX_EXTRAPOLATION_TIMES << "个";
             return false;
         }
 
         // 1.更新外推点为新航迹点
+        begin_write(source_pool_index);
+        begin_write(target_pool_index);
         for (size_t i = 1; i <= MAX_EXTRAPOLATION_TIMES; i++)
         {
             target_track.data[target_size - i] = source_track.data[source_size - i];
         }
 
-        // 2.交换航迹状态，更新内存池索引
-        std::swap(target_track.header, source_track.header);
-        source_it->second = target_pool_index;
+        // 2.ID与槽位绑定，改为交换两槽位的点迹存储（仅交换指针），源航迹在原槽位接管融合后的数据
+        std::swap(target_track.data, source_track.data);
+        std::swap(target_track.size_class, source_track.size_class);
+        source_track.last_update_ms = std::max(source_track.last_update_ms, target_track.last_update_ms);
+        header_at(source_pool_index).point_num = static_cast<std::uint32_t>(source_track.data.size());
+        end_write(target_pool_index);
+        end_write(source_pool_index);
+        const TrackPoint &latest = source_track.data[source_track.data.size() - 1];
+        spatial_grid_.update(source_pool_index, source_track_id, latest.longitude, latest.latitude);
+        journal_.mark_dirty(source_pool_index);
+        publish_event(TrackEventType::MERGED, source_track_id, target_track_id, header_at(source_pool_index).state, &latest);
 
         // 3.删除target_id对应的容器
         delete_track(target_track_id);
@@ -170,54 +359,374 @@ namespace track_project::trackmanager
         return true;
     }
 
-    // 重置整个缓冲区,所有内存池改为空弦状态，重置内存编号
+    // 重置整个缓冲区,所有航迹释放，代数递增使旧ID全部失效
     void TrackerManager::clear_all()
     {
+        free_slots_.clear();
+        active_ids_.clear();
+        spatial_grid_.clear();
+        journal_.mark_cleared();
+        aging_wheel_.clear();
+        publish_event(TrackEventType::CLEARED, 0, 0, 0, nullptr);
+
+        // 1.撤销全部航迹的发布并归还点迹存储
+        for (std::uint32_t slot = 0; slot < capacity_; ++slot)
+        {
+            if (slot_ids_[slot] == 0)
+                continue;
+            begin_write(slot);
+            published_ids_[slot].store(0, std::memory_order_seq_cst);
+            header_at(slot).clear();
+            release_points(slot);
+            end_write(slot);
+            slot_ids_[slot] = 0;
+            slot_generations_[slot]++;
+        }
 
-        for (auto &buffer : buffer_pool_)
+        // 2.按槽位顺序重建空闲队列，退役槽位不再加入
+        for (std::uint32_t slot = 0; slot < capacity_; ++slot)
         {
-            buffer.clear();
+            if (slot_generations_[slot] < max_generation_)
+            {
+                free_slots_.push_back(slot);
+            }
         }
-        track_id_to_pool_index_.clear();
-        free_slots_.clear();
+    }
 
-        // 重建空闲槽位列表
-        for (std::uint32_t i = 0; i < buffer_pool_.size(); ++i)
+    // 老化扫描：时间轮到期时才读取航迹的最后更新时刻，超时的航迹按普通删除流程处理
+    size_t TrackerManager::expire_silent_tracks(std::int64_t now_ms, std::int64_t timeout_ms,
+                                                std::vector<std::uint32_t> &expired_ids)
+    {
+        expired_ids.clear();
+        if (!aging_enabled_)
+            return 0;
+        aging_wheel_.advance(now_ms, timeout_ms, [this](std::uint32_t slot, std::uint32_t track_id, std::int64_t &last_ms)
+                             {
+                                 if (slot >= capacity_ || slot_ids_[slot] != track_id)
+                                     return false;
+                                 last_ms = std::max(last_ms, buffer_at(slot).last_update_ms);
+                                 return true; },
+                             expired_ids);
+
+        for (std::uint32_t track_id : expired_ids)
         {
-            free_slots_.push_back(i);
+            LOG_DEBUG << "航迹" << track_id << "静默超时，删除";
+            delete_track(track_id);
         }
+        return expired_ids.size();
+    }
 
-        next_track_id_ = 1;
+    // 关闭时旧条目整体丢弃，时间轮不会因航迹反复创建删除而增长
+    void TrackerManager::set_aging_enabled(bool enabled)
+    {
+        if (enabled == aging_enabled_)
+            return;
+        aging_enabled_ = enabled;
+        aging_wheel_.clear();
+        if (!enabled)
+            return;
+
+        const std::int64_t now_ms = ingest_clock_ms();
+        for (std::uint32_t track_id : active_ids_)
+        {
+            const std::uint32_t slot = slot_of(track_id);
+            buffer_at(slot).last_update_ms = now_ms;
+            aging_wheel_.schedule(slot, track_id);
+        }
+    }
+
+    // 新消费者：补记全部现存航迹
+    int TrackerManager::register_change_consumer()
+    {
+        int consumer = journal_.register_consumer();
+        if (consumer < 0)
+        {
+            LOG_ERROR << "注册变更消费者失败，已达到上限" << TrackJournal::MAX_CONSUMERS;
+            return -1;
+        }
+        for (std::uint32_t track_id : active_ids_)
+        {
+            journal_.mark_dirty_for(consumer, slot_of(track_id));
+        }
+        return consumer;
+    }
+
+    void TrackerManager::poll_changes(int consumer, TrackChanges &changes)
+    {
+        // 删除记录溢出的消费者按新注册处理，补全全部现有航迹
+        if (journal_.take_resync(consumer))
+        {
+            for (std::uint32_t track_id : active_ids_)
+            {
+                journal_.mark_dirty_for(consumer, slot_of(track_id));
+            }
+        }
+        journal_.poll(consumer, changes, [this](std::uint32_t slot)
+                      { return slot < capacity_ ? slot_ids_[slot] : 0; });
+    }
+
+    // 收缩：从末尾逐块检查，整块空闲且高于初始容量时释放
+    void TrackerManager::shrink_to_fit()
+    {
+        const std::uint32_t min_chunks = (initial_capacity_ + SLOT_CHUNK_MASK) >> SLOT_CHUNK_BITS;
+        const std::uint32_t used_chunks = (capacity_ + SLOT_CHUNK_MASK) >> SLOT_CHUNK_BITS;
+        std::uint32_t chunk_count = used_chunks;
+
+        while (chunk_count > min_chunks)
+        {
+            std::uint32_t begin = (chunk_count - 1) << SLOT_CHUNK_BITS;
+            std::uint32_t end = std::min(capacity_, chunk_count << SLOT_CHUNK_BITS);
+            bool idle = std::all_of(slot_ids_.begin() + begin, slot_ids_.begin() + end, [](std::uint32_t id)
+                                    { return id == 0; });
+            if (!idle)
+                break;
+            chunk_count--;
+        }
+
+        if (chunk_count < used_chunks)
+        {
+            std::uint32_t new_capacity = std::max(initial_capacity_, std::min(capacity_, chunk_count << SLOT_CHUNK_BITS));
+            LOG_INFO << "航迹内存池收缩：" << capacity_ << " -> " << new_capacity;
+
+            // 空闲列表中去掉被释放的槽位，代数保留供重新扩容时继续使用
+            free_slots_.remove_if([new_capacity](std::uint32_t slot)
+                                  { return slot >= new_capacity; });
+            slot_ids_.resize(new_capacity);
+            active_pos_.resize(new_capacity);
+            slot_ids_.shrink_to_fit();
+            active_pos_.shrink_to_fit();
+            capacity_ = new_capacity;
+
+            // 块内槽位均已撤销发布，此前开始的读取会话仍可能在访问，记下摘除纪元，会话结束后再释放
+            chunk_release_epoch_ = epochs_.retire();
+        }
+        reclaim_chunks();
+
+        size_t trimmed = point_pool_.trim();
+        LOG_DEBUG << "点迹存储归还" << trimmed << "字节";
+    }
+
+    // 摘除航迹：先撤销发布，此后新的读取无法再找到该航迹
+    void TrackerManager::unlink_slot(std::uint32_t slot)
+    {
+        begin_write(slot);
+        published_ids_[slot].store(0, std::memory_order_seq_cst);
+        header_at(slot).clear();
+        release_points(slot);
+        end_write(slot);
+        spatial_grid_.remove(slot);
+
+        // 交换删除：末尾元素填补空位
+        std::uint32_t pos = active_pos_[slot];
+        std::uint32_t last_id = active_ids_.back();
+        active_ids_[pos] = last_id;
+        active_pos_[slot_of(last_id)] = pos;
+        active_ids_.pop_back();
+
+        slot_ids_[slot] = 0;
+        slot_generations_[slot]++;
+    }
+
+    // 归还点迹存储，须在写入序号内调用
+    void TrackerManager::release_points(std::uint32_t slot)
+    {
+        TrackBuffer &track = buffer_at(slot);
+        point_pool_.release(track.data.detach(), track.size_class);
+        track.size_class = 0;
+    }
+
+    // 槽位放回空闲队列，代数用尽则退役
+    void TrackerManager::release_slot(std::uint32_t slot)
+    {
+        if (slot_generations_[slot] < max_generation_)
+        {
+            free_slots_.push_back(slot);
+        }
+        else
+        {
+            LOG_INFO << "槽位" << slot << "代数耗尽，退役不再分配";
+        }
+    }
+
+    // 收缩后保留的块在摘除纪元早于全部在读会话时释放；其间重新扩容会直接复用这些块
+    void TrackerManager::reclaim_chunks()
+    {
+        const std::uint32_t used_chunks = (capacity_ + SLOT_CHUNK_MASK) >> SLOT_CHUNK_BITS;
+        if (header_chunks_.size() <= used_chunks || chunk_release_epoch_ >= epochs_.safe_epoch())
+            return;
+        header_chunks_.resize(used_chunks);
+        buffer_chunks_.resize(used_chunks);
+    }
+
+    // 申请下一级存储，按逻辑顺序搬迁已有点迹后归还旧存储；申请失败时保持原存储不变
+    bool TrackerManager::promote_track(std::uint32_t slot)
+    {
+        TrackBuffer &track = buffer_at(slot);
+        std::uint32_t next_class = track.size_class + 1;
+        TrackPoint *new_block = point_pool_.acquire(next_class);
+        if (!new_block)
+        {
+            LOG_ERROR << "航迹" << slot_ids_[slot] << "无法搬迁到第" << next_class << "级存储，该级已用尽";
+            return false;
+        }
+        TrackPoint *old_block = track.data.storage();
+
+        track.data.rebind(new_block, point_pool_.class_length(next_class));
+        point_pool_.release(old_block, track.size_class);
+        track.size_class = next_class;
+        return true;
+    }
+
+    // 顺序扫描航迹头数组，空闲槽位的state为-1或3，不计入
+    TrackerManager::TrackStateCounts TrackerManager::count_track_states() const
+    {
+        TrackStateCounts counts;
+        for (std::uint32_t base = 0; base < capacity_; base += SLOT_CHUNK_SIZE)
+        {
+            // 最后一块只扫描到capacity_，块内超出容量的槽位不属于本管理器
+            const TrackerHeader *chunk = header_chunks_[base >> SLOT_CHUNK_BITS].get();
+            const std::uint32_t count = std::min<std::uint32_t>(SLOT_CHUNK_SIZE, capacity_ - base);
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                const TrackerHeader &header = chunk[i];
+                counts.normal += (header.state == 0);
+                counts.extrapolating += (header.state == 1);
+                counts.terminated += (header.state == 2);
+            }
+        }
+        return counts;
+    }
+
+    // 下一次create_track将返回的ID
+    size_t TrackerManager::get_next_track_id() const
+    {
+        if (!free_slots_.empty())
+            return make_track_id(free_slots_.front());
+
+        // 扩容后第一个未退役的新槽位
+        for (std::uint32_t slot = capacity_; slot < track_ceiling_; ++slot)
+        {
+            std::uint32_t generation = slot < slot_generations_.size() ? slot_generations_[slot] : 0;
+            if (generation < max_generation_)
+                return (generation << index_bits_) | (slot + 1);
+        }
+        return 0;
     }
 
     // 获取活跃的航迹号,返回一个包含所有活跃航迹ID的向量
     std::vector<std::uint32_t> TrackerManager::get_active_track_ids() const
     {
-        std::vector<std::uint32_t> active_ids;
-        active_ids.reserve(track_id_to_pool_index_.size());
-        for (const auto &pair : track_id_to_pool_index_)
+        return active_ids_;
+    }
+    // 读取方：先在序号不变的前提下取得航迹头与点迹的两段视图，再按视图拷贝点迹并再次校验
+    // 视图经过校验后才拷贝，保证拷贝范围落在同一块存储内
+    //
+    // 良性竞争的前提：航迹头、缓冲区视图与点迹以普通读取拷贝，与写入方的修改并发（序号锁的惯例，
+    // 按C++内存模型属数据竞争，ThreadSanitizer构建中这些拷贝以SEQLOCK_READ_BEGIN/END标注为不登记的读取），结果只在两次序号相同时使用。
+    // 为此读取期间涉及的内存必须始终可读、且拷贝不依赖撕裂的值：
+    // 1、点迹块来自TrackPointPool的mmap存储区，promote_track归还的旧块只进入空闲链表，
+    //    trim只madvise(MADV_DONTNEED)（再读为零页），存储区到管理器析构才munmap；视图校验后长度不超过块长
+    // 2、槽位删除后立即复用，创建、写入、删除对航迹头与缓冲区的修改都在写入序号内，读到的视图须序号不变且航迹头ID相符才使用；
+    //    航迹头与缓冲区所在的块由会话纪元保护，shrink_to_fit收缩后的块等会话结束才释放；块指针数组构造时按容量硬上限预留，不重新分配
+    // 3、TrackerHeader与TrackPoint可平凡拷贝，撕裂的拷贝被丢弃而不会被解释
+    bool TrackerManager::read_track(std::uint32_t track_id, TrackerHeader *header, std::vector<TrackPoint> *points,
+                                    TrackPoint *latest) const
+    {
+        static_assert(std::is_trivially_copyable_v<TrackerHeader> && std::is_trivially_copyable_v<TrackPoint>,
+                      "序号锁读取要求航迹头与点迹可平凡拷贝");
+
+        std::uint32_t slot = slot_of(track_id);
+        if (track_id == 0 || slot >= track_ceiling_)
+            return false;
+
+        const std::atomic<std::uint32_t> &published = published_ids_[slot];
+        for (std::uint32_t attempt = 0;; ++attempt)
+        {
+            if (attempt >= READ_SPIN_LIMIT)
+            {
+                std::this_thread::yield();
+            }
+            if (published.load(std::memory_order_seq_cst) != track_id)
+                return false;
+
+            const TrackBuffer &track = buffer_at(slot);
+            const std::uint32_t sequence = track.sequence.load(std::memory_order_acquire);
+            if (sequence & 1)
+                continue;
+
+            // 1.航迹头与点迹视图
+            SEQLOCK_READ_BEGIN();
+            TrackerHeader header_copy = header_at(slot);
+            auto segments = track.data.segments();
+            SEQLOCK_READ_END();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (track.sequence.load(std::memory_order_relaxed) != sequence)
+                continue;
+
+            // 发布ID在取序号前检查，其间槽位可能已被删除甚至分配给新航迹，读到的是另一条航迹的一致内容；以航迹头为准
+            if (header_copy.track_id != track_id)
+                return false;
+
+            // 2.按视图拷贝点迹
+            const size_t count = segments.first.size() + segments.second.size();
+            if (points)
+            {
+                points->resize(count);
+            }
+            SEQLOCK_READ_BEGIN();
+            if (points)
+            {
+                std::memcpy(points->data(), segments.first.data(), segments.first.size() * sizeof(TrackPoint));
+                std::memcpy(points->data() + segments.first.size(), segments.second.data(), segments.second.size() * sizeof(TrackPoint));
+            }
+            if (latest && count > 0)
+            {
+                *latest = segments.second.empty() ? segments.first[segments.first.size() - 1]
+                                                  : segments.second[segments.second.size() - 1];
+            }
+            SEQLOCK_READ_END();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (track.sequence.load(std::memory_order_relaxed) != sequence)
+                continue;
+
+            if (latest && count == 0)
+                return false;
+            if (header)
+                *header = header_copy;
+            return true;
+        }
+    }
+
+    // 顺序扫描已发布的航迹ID
+    size_t TrackerManager::ReadSession::read_active_ids(std::vector<std::uint32_t> &track_ids) const
+    {
+        track_ids.clear();
+        if (!valid())
+            return 0;
+        for (std::uint32_t slot = 0; slot < manager_->track_ceiling_; ++slot)
         {
-            active_ids.push_back(pair.first);
+            std::uint32_t track_id = manager_->published_ids_[slot].load(std::memory_order_acquire);
+            if (track_id != 0)
+                track_ids.push_back(track_id);
         }
-        return active_ids;
+        return track_ids.size();
     }
+
     // 获取id对应的航迹头部只读引用，若不存在返回nullptr
     const TrackerManager::TrackerHeader *TrackerManager::get_header_ref(std::uint32_t track_id) const
     {
-        auto it = track_id_to_pool_index_.find(track_id);
-        if (it == track_id_to_pool_index_.end())
+        std::uint32_t pool_index = resolve_slot(track_id);
+        if (pool_index == INVALID_SLOT)
             return nullptr;
-        const TrackerContainer &track = buffer_pool_[it->second];
-        return &track.header;
+        return &header_at(pool_index);
     }
 
     // 获取id对应的航迹数据只读引用，若不存在返回nullptr
     const LatestKBuffer<TrackerManager::TrackPoint> *TrackerManager::get_data_ref(std::uint32_t track_id) const
     {
-        auto it = track_id_to_pool_index_.find(track_id);
-        if (it == track_id_to_pool_index_.end())
+        std::uint32_t pool_index = resolve_slot(track_id);
+        if (pool_index == INVALID_SLOT)
             return nullptr;
-        const TrackerContainer &track = buffer_pool_[it->second];
-        return &track.data;
+        return &buffer_at(pool_index).data;
     }
 }
@@ -17,16 +17,27 @@
 #define _TRACKER_MANAGER_HPP_
 
 // 标准库文件
+#include <atomic>
 #include <memory>
 #include <vector>
-#include <unordered_map>
+#include <climits>
+#include <cstdint>
 #include <cstring>
+#include <string>
+#include <ctime>
 
 // 全局头文件
 #include "../include/defstruct.h"
 
 // 数据结构
 #include "LatestKBuffer.hpp"
+#include "TrackPointPool.hpp"
+#include "SpatialGrid.hpp"
+#include "TrackJournal.hpp"
+#include "BoundedMpmcQueue.hpp"
+#include "TimerWheel.hpp"
+#include "EpochDomain.hpp"
+#include "SlotRing.hpp"
 namespace track_project::trackmanager
 {
 
@@ -37,35 +48,104 @@ namespace track_project::trackmanager
         using TrackPoint = track_project::TrackPoint;
         using TrackerHeader = track_project::TrackerHeader;
 
-        // 航迹基础结构
-        struct TrackerContainer
+        // 航迹点迹缓冲（冷数据），点迹存储在创建时绑定，删除时归还存储池
+        struct TrackBuffer
         {
-            TrackerHeader header; // 内存连续且平凡
-
             LatestKBuffer<TrackPoint> data;
 
-            TrackerContainer(std::uint32_t point_size) : data(point_size) {}
+            std::uint32_t size_class = 0; // 当前存储所在的级别
+
+            std::int64_t last_update_ms = 0; // 最后一次写入的时刻（写入时的系统时钟，与点迹自带时间戳无关），老化判定使用
+
+            std::atomic<std::uint32_t> sequence{0}; // 写入序号，奇数表示写入方正在修改航迹头或点迹
+        };
+
+    public:
+        // 定义最大外推次数,当>MAX_EXTRAPOLATION_TIMES时，终结对应航迹
+        static constexpr std::uint32_t MAX_EXTRAPOLATION_TIMES = 3;
+
+        // 航迹状态统计
+        struct TrackStateCounts
+        {
+            size_t normal = 0;        // state == 0
+            size_t extrapolating = 0; // state == 1
+            size_t terminated = 0;    // state == 2
+        };
+
+        /*****************************************************************************
+         * @brief 其他线程的只读会话，持有期间收缩释放的存储块不会被归还
+         * 1、每次读取按写入序号校验，读到的航迹头与点迹是同一时刻的完整内容，写入中途时重试
+         * 2、不阻塞写入方；删除的槽位立即复用，读取已删除的航迹返回false；会话应短暂持有，持有期间收缩的块延迟到会话结束后释放
+         * 3、会话只能在创建它的线程使用，同时存在的会话数上限为EpochDomain::MAX_READERS
+         *****************************************************************************/
+        class ReadSession
+        {
+        public:
+            ReadSession(ReadSession &&other) noexcept : manager_(other.manager_), reader_(other.reader_)
+            {
+                other.manager_ = nullptr;
+                other.reader_ = -1;
+            }
+
+            ReadSession(const ReadSession &) = delete;
+            ReadSession &operator=(const ReadSession &) = delete;
+            ReadSession &operator=(ReadSession &&) = delete;
+
+            ~ReadSession()
+            {
+                if (manager_)
+                    manager_->epochs_.leave(reader_);
+            }
+
+            // 会话数超过上限时无效，所有读取返回false
+            bool valid() const noexcept { return reader_ >= 0; }
+
+            // 读取航迹头，航迹不存在返回false
+            bool read_header(std::uint32_t track_id, TrackerHeader &header) const
+            {
+                return valid() && manager_->read_track(track_id, &header, nullptr, nullptr);
+            }
 
-            void clear()
+            // 读取最新点迹，航迹不存在或没有点迹返回false
+            bool read_latest(std::uint32_t track_id, TrackPoint &point) const
             {
-                header.clear();
-                data.clear();
+                return valid() && manager_->read_track(track_id, nullptr, nullptr, &point);
             }
+
+            // 读取航迹头与全部点迹（旧->新），二者属于同一时刻
+            bool read_track(std::uint32_t track_id, TrackerHeader &header, std::vector<TrackPoint> &points) const
+            {
+                return valid() && manager_->read_track(track_id, &header, &points, nullptr);
+            }
+
+            // 读取当前活跃航迹ID，结果覆盖写入，顺序为槽位顺序
+            size_t read_active_ids(std::vector<std::uint32_t> &track_ids) const;
+
+        private:
+            friend class TrackerManager;
+
+            explicit ReadSession(const TrackerManager *manager) : manager_(manager), reader_(manager->epochs_.enter()) {}
+
+            const TrackerManager *manager_;
+            int reader_;
         };
 
     public: // 航迹操作接口
         /*****************************************************************************
          * @brief 构造新的 Tracker Manager 对象
          *
-         * @param track_size 航迹容量上限
+         * @param track_size 初始航迹容量
          * @param point_size 点迹容量上限
+         * @param use_huge_pages 点迹存储区是否尝试使用大页
+         * @param track_ceiling 航迹容量硬上限，空闲槽位用尽时按块扩容直到该值；小于track_size时不扩容
          *****************************************************************************/
-        TrackerManager(std::uint32_t track_size = 2000, std::uint32_t track_length = 2000);
+        TrackerManager(std::uint32_t track_size = 2000, std::uint32_t track_length = 2000,
+                       bool use_huge_pages = false, std::uint32_t track_ceiling = 0);
 
         /*****************************************************************************
          * @brief 创建新航迹
          *
-         * @return 航迹ID，如果内存池已满返回0
+         * @return 航迹ID，如果内存池已满且达到容量硬上限返回0
          *****************************************************************************/
         std::uint32_t create_track();
 
@@ -86,6 +166,19 @@ namespace track_project::trackmanager
          *****************************************************************************/
         bool push_track_point(std::uint32_t track_id, TrackPoint point);
 
+        /*****************************************************************************
+         * @brief 批量存入点迹，语义等同于逐条调用push_track_point
+         * 先按批次顺序解析全部ID（与前一条同一航迹时沿用其结果），不按槽位排序或分组，
+         * 再按批次顺序带预取地一次性执行状态机，同一航迹内自然保持原顺序
+         * 每批10000点、2000/20000条航迹交错时约为逐条调用的1.1~1.4倍吞吐（单核Release，tests/Benchmark_TEST.cpp），未达到2倍目标
+         *
+         * @param batch 航迹头（仅使用track_id）与点迹对
+         * @param terminated_ids 输出：本批次中返回FALSE的航迹ID（已终结或不存在），去重
+         * @return size_t 成功写入的点迹数
+         *****************************************************************************/
+        size_t push_track_points(const std::vector<std::pair<TrackerHeader, TrackPoint>> &batch,
+                                 std::vector<std::uint32_t> &terminated_ids);
+
         /*****************************************************************************
          * @brief 将两条航迹合并（将源航迹数据追加到目标航迹），然后以源航迹的ID号存活下去
          *
@@ -102,6 +195,78 @@ namespace track_project::trackmanager
          *****************************************************************************/
         void clear_all();
 
+        /*****************************************************************************
+         * @brief 老化扫描：删除最后更新时刻早于 now_ms - timeout_ms 的航迹
+         * 最后更新时刻为最近一次创建、写入点迹、融合或从检查点恢复时的系统时钟，不读取点迹自带的时间戳，
+         * 点迹时间可以是任意时间基准（如雷达时间、回放数据）
+         * 经分层时间轮只处理到期的航迹，代价与到期数量成正比；删除走delete_track，发布DELETED事件
+         *
+         * @param now_ms 当前时刻，须为系统时钟毫秒（Timestamp::now().milliseconds）
+         * @param timeout_ms 静默超时（毫秒）
+         * @param expired_ids 输出：本次删除的航迹ID
+         * @return size_t 删除的航迹数
+         *****************************************************************************/
+        size_t expire_silent_tracks(std::int64_t now_ms, std::int64_t timeout_ms,
+                                    std::vector<std::uint32_t> &expired_ids);
+
+        /*****************************************************************************
+         * @brief 开关静默老化，默认开启
+         * 关闭时清空时间轮，新航迹不再挂入，expire_silent_tracks不删除任何航迹；
+         * 重新开启时全部现存航迹以当前时刻为最后更新时间挂入
+         *****************************************************************************/
+        void set_aging_enabled(bool enabled);
+        bool is_aging_enabled() const noexcept { return aging_enabled_; }
+
+        /*****************************************************************************
+         * @brief 注册变更消费者，首次拉取得到cleared标记与全部现存航迹
+         * @return 消费者编号，超过TrackJournal::MAX_CONSUMERS个返回-1
+         *****************************************************************************/
+        int register_change_consumer();
+
+        void unregister_change_consumer(int consumer) { journal_.unregister_consumer(consumer); }
+
+        /*****************************************************************************
+         * @brief 拉取消费者上次拉取以来的变更：新建/追加/融合的存活航迹ID、删除的航迹ID、是否清空
+         * 代价与变更的航迹数成正比，同一航迹多次变更只报告一次
+         *****************************************************************************/
+        void poll_changes(int consumer, TrackChanges &changes);
+
+        /*****************************************************************************
+         * @brief 设置生命周期事件队列，创建、状态变化、融合、删除、清空时发布事件
+         * 队列满时丢弃并计数，不阻塞管理器；nullptr关闭发布
+         *
+         * @param queue 事件队列，生命周期须长于本对象或在析构前置空
+         *****************************************************************************/
+        void set_event_queue(BoundedMpmcQueue<TrackEvent> *queue) noexcept { event_queue_ = queue; }
+
+        /*****************************************************************************
+         * @brief 保存检查点：航迹头、槽位代数、空闲列表、活跃ID与全部点迹写入版本化二进制文件
+         * 先写入 path.tmp 再改名，失败时不破坏已有文件；格式见TrackCheckpoint.hpp
+         *
+         * @return bool 写入是否成功
+         *****************************************************************************/
+        bool save_checkpoint(const std::string &path) const;
+
+        /*****************************************************************************
+         * @brief 恢复检查点：映射文件并校验后清空当前航迹，按文件重建内存池
+         * 航迹ID、下一个分配的ID与空闲列表顺序均与保存时一致，变更日志消费者收到cleared与全部航迹
+         * 航迹长度与ID编码参数须与保存方相同，容量硬上限不得小于保存时的容量，且不能有未结束的读取会话
+         *
+         * @return bool 文件不存在、格式不符或校验失败时返回false，管理器保持原状
+         *****************************************************************************/
+        bool load_checkpoint(const std::string &path);
+
+        /*****************************************************************************
+         * @brief 释放收缩时因读取会话未结束而保留的存储块，收缩时也会自动调用
+         *****************************************************************************/
+        void reclaim_chunks();
+
+        /*****************************************************************************
+         * @brief 收缩内存：释放末尾完全空闲的扩容块（不低于初始容量），并将空闲点迹块的物理页还给系统
+         * 只释放末尾的块，仍在使用的航迹引用不受影响
+         *****************************************************************************/
+        void shrink_to_fit();
+
         // 唯一存在的流水线组件，禁止拷贝，移动
         TrackerManager(const TrackerManager &) = delete;
         TrackerManager &operator=(const TrackerManager &) = delete;
@@ -110,46 +275,241 @@ namespace track_project::trackmanager
 
         ~TrackerManager() = default;
 
-    public: // 对外只读接口
+    public: // 对外只读接口，除read_session外只能在写入线程调用
+        /*****************************************************************************
+         * @brief 开启只读会话，可在任意线程调用，见ReadSession
+         *****************************************************************************/
+        ReadSession read_session() const { return ReadSession(this); }
+
         /*****************************************************************************
-         * @brief 对外接口：获取当前活跃的航迹ID列表（只读）
+         * @brief 对外接口：获取当前活跃的航迹ID列表（只读拷贝）
          *****************************************************************************/
         std::vector<std::uint32_t> get_active_track_ids() const;
 
+        /*****************************************************************************
+         * @brief 活跃航迹ID的紧凑数组视图，不申请内存
+         * 注意：视图在下一次创建、删除、融合、清空前有效，删除采用交换删除，顺序不稳定
+         *****************************************************************************/
+        BufferSpan<const std::uint32_t> active_track_ids() const
+        {
+            return BufferSpan<const std::uint32_t>(active_ids_.data(), active_ids_.size());
+        }
+
+        /*****************************************************************************
+         * @brief 按紧凑数组顺序遍历所有活跃航迹，不申请内存
+         *
+         * @param visitor 可调用对象，签名 void(const TrackerHeader &, const LatestKBuffer<TrackPoint> &)
+         *****************************************************************************/
+        template <typename Visitor>
+        void for_each_active(Visitor &&visitor) const
+        {
+            for (std::uint32_t track_id : active_ids_)
+            {
+                std::uint32_t slot = slot_of(track_id);
+                visitor(header_at(slot), buffer_at(slot).data);
+            }
+        }
+
         /*****************************************************************************
          * @brief 返回对航迹头部的只读引用（若不存在返回 nullptr）
-         * 注意：返回的引用在对应航迹被删除或被写改前保持有效。
+         * 注意：返回的引用在对应航迹被删除或被写改前保持有效；其他线程请使用read_session。
          *****************************************************************************/
         const TrackerHeader *get_header_ref(std::uint32_t track_id) const;
 
         /*****************************************************************************
          * @brief 返回对航迹数据缓冲区的只读引用（若不存在返回 nullptr）
          * 返回类型为 `const LatestKBuffer<TrackPoint>*`，允许外部直接按索引访问而不拷贝。
-         * 注意生命周期：引用在对应航迹被删除或写改前有效。
+         * 注意生命周期：引用在对应航迹被删除或写改前有效；其他线程请使用read_session。
          *****************************************************************************/
         const LatestKBuffer<TrackPoint> *get_data_ref(std::uint32_t track_id) const;
 
-        // 统计信息
-        size_t get_total_capacity() const { return buffer_pool_.size(); }
-        size_t get_used_count() const { return track_id_to_pool_index_.size(); }
-        size_t get_next_track_id() const { return next_track_id_; }
-        bool is_valid_track(std::uint32_t track_id) const
+        /*****************************************************************************
+         * @brief 空间查询：按各航迹最新点迹位置检索，结果覆盖写入track_ids
+         * 索引随点迹写入、删除、融合、清空增量维护，只访问查询范围覆盖的网格
+         *
+         * @param radius_m 半径（米）
+         *****************************************************************************/
+        void query_radius(double longitude, double latitude, double radius_m,
+                          std::vector<std::uint32_t> &track_ids) const
         {
-            return track_id_to_pool_index_.find(track_id) != track_id_to_pool_index_.end();
+            track_ids.clear();
+            spatial_grid_.query_radius(longitude, latitude, radius_m, track_ids);
         }
 
+        void query_box(double min_longitude, double min_latitude, double max_longitude, double max_latitude,
+                       std::vector<std::uint32_t> &track_ids) const
+        {
+            track_ids.clear();
+            spatial_grid_.query_box(min_longitude, min_latitude, max_longitude, max_latitude, track_ids);
+        }
+
+        // 统计信息
+        size_t get_total_capacity() const { return capacity_; }
+        size_t get_capacity_ceiling() const { return track_ceiling_; }
+        size_t get_high_water_mark() const { return high_water_mark_; } // 历史最大同时活跃航迹数
+        size_t get_used_count() const { return active_ids_.size(); }
+        size_t get_next_track_id() const; // 下一次create_track将返回的ID，内存池已满返回0
+        size_t get_point_storage_bytes() const { return point_pool_.used_bytes(); }
+        size_t get_aging_entry_count() const { return aging_wheel_.size(); } // 时间轮中的条目数，含已删除航迹尚未到期的旧条目
+        std::uint32_t get_max_generation() const { return max_generation_; } // 槽位代数上限，达到后槽位退役
+        bool is_valid_track(std::uint32_t track_id) const { return resolve_slot(track_id) != INVALID_SLOT; }
+
+        /*****************************************************************************
+         * @brief 统计各状态航迹数量，只顺序扫描连续的航迹头数组，不触碰点迹数据
+         *****************************************************************************/
+        TrackStateCounts count_track_states() const;
+
         // 测试类专用友元
         friend class TrackerManagerDebugger;
 
     private:
-        // 内存池
-        std::vector<TrackerContainer> buffer_pool_;
+        // 无效槽位标记
+        static constexpr std::uint32_t INVALID_SLOT = UINT32_MAX;
+
+        // 每个存储块的槽位数
+        static constexpr std::uint32_t SLOT_CHUNK_BITS = 8;
+        static constexpr std::uint32_t SLOT_CHUNK_SIZE = std::uint32_t(1) << SLOT_CHUNK_BITS;
+        static constexpr std::uint32_t SLOT_CHUNK_MASK = SLOT_CHUNK_SIZE - 1;
+
+        // 按槽位访问分块存储
+        TrackerHeader &header_at(std::uint32_t slot) { return header_chunks_[slot >> SLOT_CHUNK_BITS][slot & SLOT_CHUNK_MASK]; }
+        const TrackerHeader &header_at(std::uint32_t slot) const { return header_chunks_[slot >> SLOT_CHUNK_BITS][slot & SLOT_CHUNK_MASK]; }
+        TrackBuffer &buffer_at(std::uint32_t slot) { return buffer_chunks_[slot >> SLOT_CHUNK_BITS][slot & SLOT_CHUNK_MASK]; }
+        const TrackBuffer &buffer_at(std::uint32_t slot) const { return buffer_chunks_[slot >> SLOT_CHUNK_BITS][slot & SLOT_CHUNK_MASK]; }
+
+        // 扩容到new_capacity：补齐存储块与管理数组，新槽位按序排到空闲队列队尾
+        void grow_to(std::uint32_t new_capacity);
+
+        /*****************************************************************************
+         * @brief 航迹ID编码：低 index_bits_ 位为 槽位号+1，高位为该槽位的代数
+         * 1. 解析只需一次位运算、一次数组访问和一次比较，过期ID因代数不同被拒绝
+         * 2. 槽位号+1 保证ID非0，新管理器首轮分配的ID依次为1、2、3...
+         * 3. 槽位代数用尽后该槽位退役不再分配，保证管理器生命周期内ID不重复
+         *****************************************************************************/
+        std::uint32_t make_track_id(std::uint32_t slot) const
+        {
+            return (slot_generations_[slot] << index_bits_) | (slot + 1);
+        }
+
+        // 写入时刻：系统时钟的粗粒度读数（毫秒级精度），与Timestamp::now()同一时间基准，开销远低于精确时钟
+        static std::int64_t ingest_clock_ms() noexcept
+        {
+            timespec ts;
+            ::clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+            return std::int64_t(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+        }
+
+        // 从ID中取出槽位号，不做有效性检查
+        std::uint32_t slot_of(std::uint32_t track_id) const
+        {
+            return (track_id & index_mask_) - 1;
+        }
+
+        // 解析航迹ID到槽位号，ID不存在或已过期返回INVALID_SLOT
+        std::uint32_t resolve_slot(std::uint32_t track_id) const
+        {
+            std::uint32_t slot = slot_of(track_id);
+            if (slot >= capacity_ || slot_ids_[slot] != track_id)
+                return INVALID_SLOT;
+            return slot;
+        }
+
+        // 发布生命周期事件，point为空时不带位置
+        void publish_event(TrackEventType type, std::uint32_t track_id, std::uint32_t related_id,
+                           int state, const TrackPoint *point)
+        {
+            if (!event_queue_)
+                return;
+            TrackEvent event;
+            event.type = type;
+            event.state = static_cast<std::int8_t>(state);
+            event.track_id = track_id;
+            event.related_id = related_id;
+            if (point)
+            {
+                event.longitude = point->longitude;
+                event.latitude = point->latitude;
+                event.time_ms = point->time.milliseconds;
+            }
+            event_queue_->push_or_drop(event);
+        }
+
+        // 写入方修改槽位内容前后各调用一次，读取方据序号判断读到的内容是否完整
+        void begin_write(std::uint32_t slot)
+        {
+            std::atomic<std::uint32_t> &sequence = buffer_at(slot).sequence;
+            sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        void end_write(std::uint32_t slot)
+        {
+            std::atomic<std::uint32_t> &sequence = buffer_at(slot).sequence;
+            sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        // 读取方：按写入序号读取航迹，各输出为空时跳过
+        bool read_track(std::uint32_t track_id, TrackerHeader *header, std::vector<TrackPoint> *points,
+                        TrackPoint *latest) const;
+
+        // 摘除航迹：撤销发布、清空航迹头并归还点迹存储、移出活跃数组与空间索引，代数加一，此后ID失效
+        void unlink_slot(std::uint32_t slot);
+
+        // 归还槽位的点迹存储，须在写入序号内调用
+        void release_points(std::uint32_t slot);
+
+        // 摘除后的槽位：未退役时放回空闲列表
+        void release_slot(std::uint32_t slot);
+
+        // 单点状态机，航迹终结时删除并返回false；now_ms为写入时刻，批量写入时整批共用一次读数
+        bool apply_point(std::uint32_t pool_index, const TrackPoint &point, std::int64_t now_ms);
+
+        // 航迹写满且未达长度上限时，搬迁到下一级存储；下一级用尽时返回false，航迹留在当前级别
+        bool promote_track(std::uint32_t slot);
+
+
+        // 分级点迹存储池，航迹缓冲区从中申请，须先于内存池构造、晚于内存池析构
+        TrackPointPool point_pool_;
+
+        // 内存池：按块分配，扩容只追加新块，已有元素地址不变；块内冷热分离，航迹头连续存放，点迹缓冲单独存放
+        // 收缩后超出容量的块等读取会话结束才释放，其间块数可能多于容量所需
+        std::vector<std::unique_ptr<TrackerHeader[]>> header_chunks_;
+        std::vector<std::unique_ptr<TrackBuffer[]>> buffer_chunks_;
+
+        // 最新位置空间索引
+        SpatialGrid spatial_grid_;
+
+        // 增量消费者的变更日志
+        TrackJournal journal_;
+
+        // 静默航迹老化时间轮，关闭老化时为空
+        TimerWheel aging_wheel_;
+        bool aging_enabled_ = true;
+
+        // 读取会话的纪元；收缩后超出容量的块保留到摘除纪元早于全部在读会话时才释放
+        mutable EpochDomain epochs_;
+        std::uint64_t chunk_release_epoch_ = 0;
+        std::unique_ptr<std::atomic<std::uint32_t>[]> published_ids_; // 槽位 -> 对读取方可见的航迹ID，按容量硬上限一次分配
+
+        // 生命周期事件队列，由外部持有
+        BoundedMpmcQueue<TrackEvent> *event_queue_ = nullptr;
 
         // 管理数据结构
-        std::unordered_map<std::uint32_t, std::uint32_t> track_id_to_pool_index_; // 航迹ID -> 池索引
-        std::vector<std::uint32_t> free_slots_;                                   // 空闲槽位索引
+        std::vector<std::uint32_t> slot_ids_;         // 槽位 -> 当前航迹ID，空闲为0
+        std::vector<std::uint32_t> slot_generations_; // 槽位 -> 代数，收缩时保留，保证重新扩容后ID不重复
+        SlotRing free_slots_;                         // 空闲槽位先进先出队列，队首为下一个分配的槽位
+        std::vector<std::uint32_t> active_ids_;       // 活跃航迹ID紧凑数组
+        std::vector<std::uint32_t> active_pos_;       // 槽位 -> 在active_ids_中的位置
+        std::vector<std::uint32_t> batch_slots_;      // 批量写入时解析出的槽位，复用避免反复申请
+
+        std::uint32_t capacity_;          // 当前槽位数
+        std::uint32_t initial_capacity_;  // 初始槽位数，收缩不低于该值
+        std::uint32_t track_ceiling_;     // 槽位数硬上限
+        size_t high_water_mark_ = 0;      // 历史最大同时活跃航迹数
 
-        std::uint32_t next_track_id_;     // 内部ID自增性，保证唯一性
+        std::uint32_t index_bits_;        // ID中槽位号所占位数
+        std::uint32_t index_mask_;        // 槽位号掩码
+        std::uint32_t max_generation_;    // 代数上限，超过后槽位退役
         const std::uint32_t track_length; // 每条航迹的点迹容量上限
     };
 
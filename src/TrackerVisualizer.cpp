@@ -2,21 +2,23 @@
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 
 namespace track_project::trackmanager
 {
 
     TrackerVisualizer::TrackerVisualizer(double lon_min, double lon_max,
                                          double lat_min, double lat_max,
-                                         std::uint32_t track_size, std::uint32_t track_length)
+                                         std::uint32_t /*track_size*/, std::uint32_t track_length,
+                                         std::uint32_t plot_history)
         : img(1440, 2560, CV_8UC3, cv::Scalar(255, 255, 255)),    // 彩色RGB画布，背景是白色
           bg_img(1440, 2560, CV_8UC3, cv::Scalar(255, 255, 255)), // 彩色RGB画布，背景是白色，存储背景
           lon_min(lon_min), lon_max(lon_max),
-          lat_min(lat_min), lat_max(lat_max)
+          lat_min(lat_min), lat_max(lat_max),
+          plot_history(std::max<std::uint32_t>(plot_history, 1))
     {
         height = img.rows;
         width = img.cols;
-        active_track_ids.reserve(track_size);
         track_points.reserve(track_length);
 
         LOG_DEBUG << "TrackerVisualizer初始化完成: 画布"
@@ -25,53 +27,70 @@ namespace track_project::trackmanager
                   << lat_min << "," << lat_max << "]" << std::endl;
     }
 
-    void TrackerVisualizer::draw_track(const TrackerManager &manager)
+    void TrackerVisualizer::draw_snapshot(const TrackSnapshot &snapshot)
     {
-        bg_img.copyTo(img); // 显示点迹结果
+        // 快照与背景都没有变化时画面不变，只处理窗口事件
+        if (snapshot.sequence == drawn_sequence && !background_dirty)
+        {
+            cv::waitKey(1);
+            return;
+        }
+        drawn_sequence = snapshot.sequence;
+        background_dirty = false;
 
-        // 使用公开只读接口获取活跃航迹ID
-        active_track_ids = manager.get_active_track_ids();
+        bg_img.copyTo(img); // 显示点迹结果
 
-        for (auto track_id : active_track_ids)
+        for (size_t i = 0; i < snapshot.size(); ++i)
         {
-            draw_single_track(track_id, manager);
+            draw_single_track(snapshot.headers[i].track_id, snapshot.track_points(i), BufferSpan<const TrackPoint>());
         }
 
         cv::imshow("Track Visualizer", img);
-        cv::waitKey(10);
+        cv::waitKey(1);
     }
 
-    void TrackerVisualizer::draw_point_cloud(std::vector<TrackPoint> x)
+    void TrackerVisualizer::draw_point_cloud(const std::vector<TrackPoint> &x)
     {
         // 重置背景为白色
         bg_img.setTo(cv::Scalar(255, 255, 255));
+        background_dirty = true;
 
         if (x.empty())
         {
-            LOG_ERROR << "TrackerVisualizer: 点迹向量为空，跳过绘制" << std::endl;
-            return;
+            LOG_ERROR << "TrackerVisualizer: 点迹向量为空，只绘制点迹历史" << std::endl;
+        }
+        for (const auto &point : x)
+        {
+            plot_history.push(point);
         }
 
-        LOG_DEBUG << "TrackerVisualizer: 开始绘制点迹，数量: " << x.size() << std::endl;
+        LOG_DEBUG << "TrackerVisualizer: 开始绘制点迹，本帧数量: " << x.size()
+                  << "，历史数量: " << plot_history.size() << std::endl;
 
-        // 绘制每个点迹
-        for (const auto &point : x)
+        // 按列遍历点迹历史，先旧后新两段
+        const auto ring = plot_history.segments();
+        const double *longitudes = plot_history.longitudes();
+        const double *latitudes = plot_history.latitudes();
+        const bool *associations = plot_history.associations();
+        for (size_t k = 0; k < ring.first_count + ring.second_count; ++k)
         {
+            const size_t pos = k < ring.first_count ? ring.first_offset + k : k - ring.first_count;
+
             // 将经纬度坐标转换为图像坐标
-            cv::Point img_point = convert_to_image_coords(point.longitude, point.latitude);
+            cv::Point img_point = convert_to_image_coords(longitudes[pos], latitudes[pos]);
 
             // 检查点是否在图像范围内
             if (img_point.x < 0 || img_point.x >= width ||
                 img_point.y < 0 || img_point.y >= height)
             {
                 LOG_DEBUG << "TrackerVisualizer: 点迹坐标超出图像范围，跳过绘制 ("
-                          << point.longitude << ", " << point.latitude << ")" << std::endl;
+                          << longitudes[pos] << ", " << latitudes[pos] << ")" << std::endl;
                 continue;
             }
 
             // 根据点迹属性选择颜色
             cv::Scalar point_color;
-            if (point.is_associated)
+            if (associations[pos])
             {
                 // 已关联的点迹使用蓝色
                 point_color = cv::Scalar(255, 0, 0); // BGR格式：蓝色
@@ -98,6 +117,7 @@ namespace track_project::trackmanager
     {
         // 将画布颜色重置为初始状态（白色背景）
         img.setTo(cv::Scalar(255, 255, 255));
+        background_dirty = true;
 
         // 清空显示窗口（如果存在）
         if (cv::getWindowProperty("Track Visualizer", cv::WND_PROP_VISIBLE) >= 0)
@@ -109,42 +129,34 @@ namespace track_project::trackmanager
         LOG_DEBUG << "TrackerVisualizer: 画布已清空，重置为初始状态" << std::endl;
     }
 
-    void TrackerVisualizer::draw_single_track(std::uint32_t track_id, const TrackerManager &manager)
+    void TrackerVisualizer::draw_single_track(std::uint32_t track_id, BufferSpan<const TrackPoint> first, BufferSpan<const TrackPoint> second)
     {
-        using TrackPoint = track_project::TrackPoint;
-        using TrackerHeader = track_project::TrackerHeader;
-
-        // 使用零拷贝只读引用获取头部和数据
-        const TrackerHeader *header_ptr = manager.get_header_ref(track_id);
-        const LatestKBuffer<TrackPoint> *data_ptr = manager.get_data_ref(track_id);
-
-        if (!header_ptr || !data_ptr)
-        {
-            LOG_ERROR << "TrackerVisualizer: 无法获取航迹" << track_id << "的只读引用，跳过";
-            return;
-        }
-
-        if (data_ptr->size() == 0)
+        if (first.empty() && second.empty())
         {
             LOG_ERROR << "TrackerVisualizer: 航迹ID" << track_id << "的航迹点为空，跳过该航迹绘制";
             return;
         }
 
-        // 坐标转换，超界点跳过
+        // 坐标转换，超界点跳过；按两段连续内存顺序遍历，避免逐点取模
         track_points.clear();
-        for (size_t i = 0; i < data_ptr->size(); ++i)
+        size_t i = 0;
+        for (const auto &segment : {first, second})
         {
-            const auto &point = (*data_ptr)[i];
-            cv::Point img_point = convert_to_image_coords(point.longitude, point.latitude);
-
-            if (img_point.x < 0 || img_point.x >= width ||
-                img_point.y < 0 || img_point.y >= height)
+            for (const auto &point : segment)
             {
-                LOG_ERROR << "航迹ID" << track_id << "点" << i << "坐标超出图像范围，跳过该点";
-                continue;
+                cv::Point img_point = convert_to_image_coords(point.longitude, point.latitude);
+
+                if (img_point.x < 0 || img_point.x >= width ||
+                    img_point.y < 0 || img_point.y >= height)
+                {
+                    LOG_ERROR << "航迹ID" << track_id << "点" << i << "坐标超出图像范围，跳过该点";
+                    ++i;
+                    continue;
+                }
+
+                track_points.push_back(img_point);
+                ++i;
             }
-
-            track_points.push_back(img_point);
         }
 
         if (track_points.size() < 2)
@@ -239,9 +251,14 @@ namespace track_project::trackmanager
     {
         ss << "系统统计:" << std::endl;
         ss << std::string(50, '-') << std::endl;
-        ss << "  总容量: " << manager.get_total_capacity() << " 个航迹" << std::endl;
-        ss << "  使用中: " << manager.get_used_count() << " 个航迹" << std::endl;
+        ss << "  总容量: " << manager.get_total_capacity() << " / " << manager.get_capacity_ceiling() << " 个航迹" << std::endl;
+        ss << "  使用中: " << manager.get_used_count() << " 个航迹（峰值 " << manager.get_high_water_mark() << "）" << std::endl;
         ss << "  下个ID: " << manager.get_next_track_id() << std::endl;
+        ss << "  点迹存储: " << manager.get_point_storage_bytes() / 1024 << " KB" << std::endl;
+
+        const auto counts = manager.count_track_states();
+        ss << "  状态分布: 正常 " << counts.normal << " / 外推 " << counts.extrapolating
+           << " / 终结 " << counts.terminated << std::endl;
     }
 
     void TrackerVisualizer::print_memory_pool(const TrackerManager &manager, std::stringstream &ss)
@@ -250,30 +267,23 @@ namespace track_project::trackmanager
         ss << std::string(50, '-') << std::endl;
 
         size_t active_count = 0;
-        std::vector<std::uint32_t> active_ids = manager.get_active_track_ids();
-
-        for (auto track_id : active_ids)
-        {
-            const track_project::TrackerHeader *header_ptr = manager.get_header_ref(track_id);
-            const LatestKBuffer<track_project::TrackPoint> *data_ptr = manager.get_data_ref(track_id);
-            if (!header_ptr || !data_ptr)
-                continue;
 
+        manager.for_each_active([&](const TrackerHeader &header, const LatestKBuffer<TrackPoint> &data)
+                                {
             active_count++;
-            ss << "  航迹" << std::setw(4) << header_ptr->track_id
-               << " [状态:" << std::setw(4) << state_to_string(header_ptr->state)
-               << ", 外推:" << std::setw(1) << header_ptr->extrapolation_count
-               << ", 点数:" << std::setw(3) << data_ptr->size() << "]";
+            ss << "  航迹" << std::setw(4) << header.track_id
+               << " [状态:" << std::setw(4) << state_to_string(header.state)
+               << ", 外推:" << std::setw(1) << header.extrapolation_count
+               << ", 点数:" << std::setw(3) << data.size() << "]";
 
             // 显示最近点的时间（如果有）
-            if (data_ptr->size() > 0)
+            if (data.size() > 0)
             {
-                const auto &latest_point = (*data_ptr)[data_ptr->size() - 1];
+                const auto &latest_point = data[data.size() - 1];
                 ss << " 最新时间:" << latest_point.time;
             }
             ss << std::endl;
-            ss << std::endl;
-        }
+            ss << std::endl; });
 
         if (active_count == 0)
         {
@@ -17,6 +17,8 @@
 
 #include <opencv2/opencv.hpp>
 #include "TrackerManager.hpp"
+#include "TrackSnapshot.hpp"
+#include "LatestKBufferSoA.hpp"
 #include "Logger.hpp"
 
 namespace track_project::trackmanager
@@ -33,25 +35,26 @@ namespace track_project::trackmanager
          * @param lat_max 纬度最大值
          * @param track_size 预分配航迹ID数量
          * @param track_length 预分配航迹点数量
+         * @param plot_history 点迹背景保留的最近点迹数（余辉），跨多次绘制累积
          *****************************************************************************/
         TrackerVisualizer(double lon_min, double lon_max, double lat_min, double lat_max,
-                          std::uint32_t track_size = 2000, std::uint32_t track_length = 2000);
+                          std::uint32_t track_size = 2000, std::uint32_t track_length = 2000,
+                          std::uint32_t plot_history = 4096);
 
         ~TrackerVisualizer() = default;
 
         /*****************************************************************************
-         * @brief 读取航迹管理器并绘制航迹
-         * 航迹用渐变黑色线条绘制，新航迹点透明度较高，历史航迹点透明度较低，标注航迹号
-         * 当航迹号错误，如内存超过范围、航迹点为0、航迹点超出边界，跳过该航迹，并报相关错误
+         * @brief 按已发布的快照绘制航迹，不访问航迹管理器，可在渲染线程调用
+         * 快照序号与点迹背景均未变化时跳过重绘，只处理窗口事件
          *
-         * @param manager 航迹管理器对象
+         * @param snapshot 活跃航迹快照
          *****************************************************************************/
-        void draw_track(const TrackerManager &manager);
+        void draw_snapshot(const TrackSnapshot &snapshot);
 
         /*****************************************************************************
-         * @brief 绘制点云
+         * @brief 绘制点云：本帧点迹追加到点迹历史，背景按历史中最近plot_history个点迹重绘
          *****************************************************************************/
-        void draw_point_cloud(std::vector<TrackPoint> x);
+        void draw_point_cloud(const std::vector<TrackPoint> &x);
 
         /*****************************************************************************
          * @brief 清楚画布上的所有航迹
@@ -78,8 +81,8 @@ namespace track_project::trackmanager
         // 坐标转换：经纬度到图像像素
         cv::Point convert_to_image_coords(double longitude, double latitude) const;
 
-        // 绘制单个航迹
-        void draw_single_track(std::uint32_t track_id, const TrackerManager &manager);
+        // 绘制单个航迹，点迹按旧->新分为至多两段连续内存
+        void draw_single_track(std::uint32_t track_id, BufferSpan<const TrackPoint> first, BufferSpan<const TrackPoint> second);
 
         // 绘制航迹线条
         void draw_track_lines(const std::vector<cv::Point> &points);
@@ -94,9 +97,17 @@ namespace track_project::trackmanager
         double lon_min, lon_max, lat_min, lat_max; // 经纬度范围
         std::uint32_t height, width;               // 画布高度和宽度
 
-        // 航迹点存放空间,为提高速度采用预分配方式，仅被draw_track使用
-        std::vector<std::uint32_t> active_track_ids;
+        // 航迹点存放空间,为提高速度采用预分配方式，绘制单条航迹时复用
         std::vector<cv::Point> track_points;
+
+        // 点迹历史，列存储：重绘背景只读取经纬度与关联标志三列
+        TrackPointColumns plot_history;
+
+        // 点迹背景或画布是否变化，变化时即使快照未变也重绘
+        bool background_dirty = true;
+
+        // 按快照绘制时上次绘制的快照序号
+        std::uint64_t drawn_sequence = 0;
     };
 
 } // namespace track_project::trackmanager
@@ -0,0 +1,97 @@
+/*****************************************************************************
+ * @file WakeEvent.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 单消费者空闲休眠与唤醒（eventfd）
+ * 1、消费者无事可做时先登记休眠，再检查一次条件，仍无事才阻塞在eventfd上
+ * 2、生产者发布数据后检查休眠标志，只有消费者确实在休眠时才写eventfd，忙时不进内核
+ * 3、登记与检查两侧各有一道全屏障，不会出现消费者漏看数据而生产者漏唤醒的情况
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _WAKE_EVENT_HPP_
+#define _WAKE_EVENT_HPP_
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+namespace track_project::trackmanager
+{
+
+    class WakeEvent
+    {
+    public:
+        WakeEvent() : fd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {}
+
+        // 持有文件描述符，禁止拷贝，移动
+        WakeEvent(const WakeEvent &) = delete;
+        WakeEvent &operator=(const WakeEvent &) = delete;
+        WakeEvent(WakeEvent &&) = delete;
+        WakeEvent &operator=(WakeEvent &&) = delete;
+
+        ~WakeEvent()
+        {
+            if (fd_ >= 0)
+                ::close(fd_);
+        }
+
+        // eventfd 是否创建成功，失败时 wait_for 退化为短暂休眠
+        bool valid() const noexcept { return fd_ >= 0; }
+
+        // 消费者：登记休眠，之后须再检查一次条件，有事可做时调用cancel_wait
+        void prepare_wait() noexcept
+        {
+            waiting_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        void cancel_wait() noexcept { waiting_.store(false, std::memory_order_relaxed); }
+
+        // 消费者：阻塞到被唤醒或超时
+        void wait_for(int timeout_ms) noexcept
+        {
+            if (fd_ >= 0)
+            {
+                pollfd pfd{fd_, POLLIN, 0};
+                ::poll(&pfd, 1, timeout_ms);
+
+                std::uint64_t count;
+                while (::read(fd_, &count, sizeof(count)) > 0)
+                {
+                }
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(FALLBACK_SLEEP_MS));
+            }
+            waiting_.store(false, std::memory_order_relaxed);
+        }
+
+        // 生产者：数据发布后调用，消费者休眠时唤醒
+        void notify() noexcept
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiting_.load(std::memory_order_relaxed) && waiting_.exchange(false, std::memory_order_acq_rel) && fd_ >= 0)
+            {
+                std::uint64_t one = 1;
+                [[maybe_unused]] ssize_t written = ::write(fd_, &one, sizeof(one));
+            }
+        }
+
+    private:
+        static constexpr int FALLBACK_SLEEP_MS = 1;
+
+        int fd_;
+        alignas(64) std::atomic<bool> waiting_{false};
+    };
+
+} // namespace track_project::trackmanager
+
+#endif // _WAKE_EVENT_HPP_
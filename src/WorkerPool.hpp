@@ -0,0 +1,179 @@
+/*****************************************************************************
+ * @file WorkerPool.hpp
+ * @author xjl (xjl20011009@126.com)
+ * @brief 固定大小的分叉-汇合线程池
+ * 1、构造时创建 thread_count-1 个常驻线程，调用线程自身也参与执行
+ * 2、run(task_count, task) 并行执行 task(0..task_count-1)，全部完成后返回
+ * 3、任务以函数指针+上下文下发，提交过程不申请内存
+ * 4、任务抛出的异常在所在线程捕获，剩余任务不再领取，汇合后在调用线程重新抛出第一个异常
+ * @version 0.1
+ * @date 2025-12-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#ifndef _WORKER_POOL_HPP_
+#define _WORKER_POOL_HPP_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+
+namespace track_project::trackmanager
+{
+
+    class WorkerPool
+    {
+    public:
+        /*****************************************************************************
+         * @brief 构造线程池
+         *
+         * @param thread_count 参与执行的线程总数（含调用线程），0按1处理
+         *****************************************************************************/
+        explicit WorkerPool(std::uint32_t thread_count)
+        {
+            std::uint32_t worker_count = thread_count > 1 ? thread_count - 1 : 0;
+            workers_.reserve(worker_count);
+            for (std::uint32_t i = 0; i < worker_count; ++i)
+            {
+                workers_.emplace_back(&WorkerPool::worker_loop, this);
+            }
+        }
+
+        ~WorkerPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            start_cv_.notify_all();
+            for (auto &worker : workers_)
+            {
+                if (worker.joinable())
+                    worker.join();
+            }
+        }
+
+        // 唯一线程资源，禁止拷贝，移动
+        WorkerPool(const WorkerPool &) = delete;
+        WorkerPool &operator=(const WorkerPool &) = delete;
+        WorkerPool(WorkerPool &&) = delete;
+        WorkerPool &operator=(WorkerPool &&) = delete;
+
+        /*****************************************************************************
+         * @brief 并行执行 task(i)，i ∈ [0, task_count)，阻塞到全部完成
+         * 不可重入：同一时刻只能有一个线程调用run
+         * 任一任务抛出异常时其余未领取的任务不再执行，全部线程汇合后重新抛出第一个异常，线程池可继续使用
+         *****************************************************************************/
+        template <typename Task>
+        void run(std::uint32_t task_count, Task &&task)
+        {
+            if (task_count == 0)
+                return;
+
+            // 无常驻线程或仅一个任务时直接串行执行
+            if (workers_.empty() || task_count == 1)
+            {
+                for (std::uint32_t i = 0; i < task_count; ++i)
+                    task(i);
+                return;
+            }
+
+            using TaskType = std::remove_reference_t<Task>;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                invoke_ = [](void *ctx, std::uint32_t i)
+                { (*static_cast<TaskType *>(ctx))(i); };
+                context_ = static_cast<void *>(&task);
+                task_count_ = task_count;
+                next_task_.store(0, std::memory_order_relaxed);
+                running_ = static_cast<std::uint32_t>(workers_.size());
+                generation_++;
+            }
+            start_cv_.notify_all();
+
+            drain();
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_cv_.wait(lock, [this]()
+                          { return running_ == 0; });
+            if (error_)
+            {
+                std::exception_ptr error = std::move(error_);
+                error_ = nullptr;
+                std::rethrow_exception(error);
+            }
+        }
+
+        // 参与执行的线程总数
+        std::uint32_t size() const noexcept { return static_cast<std::uint32_t>(workers_.size() + 1); }
+
+    private:
+        // 领取并执行任务直到任务耗尽；异常不离开本线程，记录第一个并停止领取
+        void drain()
+        {
+            std::uint32_t i;
+            while ((i = next_task_.fetch_add(1, std::memory_order_relaxed)) < task_count_)
+            {
+                try
+                {
+                    invoke_(context_, i);
+                }
+                catch (...)
+                {
+                    next_task_.store(task_count_, std::memory_order_relaxed);
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (!error_)
+                        error_ = std::current_exception();
+                }
+            }
+        }
+
+        void worker_loop()
+        {
+            std::uint64_t seen_generation = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    start_cv_.wait(lock, [&]()
+                                   { return stop_ || generation_ != seen_generation; });
+                    if (stop_)
+                        return;
+                    seen_generation = generation_;
+                }
+
+                drain();
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (--running_ == 0)
+                        done_cv_.notify_one();
+                }
+            }
+        }
+
+        std::vector<std::thread> workers_;
+
+        std::mutex mutex_;
+        std::condition_variable start_cv_;
+        std::condition_variable done_cv_;
+
+        // 当前批次任务，在mutex_保护下发布
+        void (*invoke_)(void *, std::uint32_t) = nullptr;
+        void *context_ = nullptr;
+        std::uint32_t task_count_ = 0;
+        std::atomic<std::uint32_t> next_task_{0};
+        std::uint32_t running_ = 0;
+        std::uint64_t generation_ = 0;
+        bool stop_ = false;
+        std::exception_ptr error_; // 本批次第一个任务异常，汇合后由run重新抛出
+    };
+
+} // namespace track_project::trackmanager
+
+#endif // _WORKER_POOL_HPP_
@@ -0,0 +1,77 @@
+/*****************************************************************************
+ * @file Benchmark_TEST.cpp
+ * @brief 性能基准：默认不运行（隐藏标签），readme与注释中引用的数据由此测得
+ * 运行方式：cmake -DCMAKE_BUILD_TYPE=Release 构建后执行 ./tests/Benchmark_TEST "[benchmark]"
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <utility>
+
+#include "TrackerManager.hpp"
+
+using namespace track_project;
+using namespace track_project::trackmanager;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // 重复执行取最短耗时，返回每次操作的纳秒数
+    template <typename Body>
+    double best_ns_per_op(int repeats, size_t ops, Body &&body)
+    {
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r)
+        {
+            auto start = Clock::now();
+            body();
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            best = std::min(best, ns / static_cast<double>(ops));
+        }
+        return best;
+    }
+}
+
+TEST_CASE("基准：push_track_points 批量写入与逐条 push_track_point", "[.][benchmark]")
+{
+    // 每批10000个点迹，航迹在批内随机交错；2000条航迹时航迹头与写入位置基本在缓存内，20000条时不在
+    constexpr std::uint32_t BATCH = 10000;
+    constexpr int REPEATS = 20;
+    for (std::uint32_t tracks : {2000u, 20000u})
+    {
+        TrackerManager per_point(tracks, 2000), batched(tracks, 2000);
+        std::vector<std::uint32_t> ids;
+        for (std::uint32_t i = 0; i < tracks; ++i)
+        {
+            ids.push_back(per_point.create_track());
+            REQUIRE(batched.create_track() == ids.back());
+        }
+
+        std::mt19937 rng(8);
+        std::vector<std::pair<TrackerHeader, TrackPoint>> batch(BATCH);
+        for (auto &item : batch)
+        {
+            item.first.track_id = ids[rng() % tracks];
+            item.second = test::make_point(120.0, 30.0, 1000);
+        }
+
+        std::vector<std::uint32_t> terminated;
+        const double single_ns = best_ns_per_op(REPEATS, BATCH, [&]
+                                                {
+                                                    for (const auto &item : batch)
+                                                        per_point.push_track_point(item.first.track_id, item.second); });
+        const double batch_ns = best_ns_per_op(REPEATS, BATCH, [&]
+                                               { batched.push_track_points(batch, terminated); });
+
+        WARN(tracks << "条航迹：逐条写入 " << single_ns << " ns/点，批量写入 " << batch_ns << " ns/点，加速比 " << single_ns / batch_ns);
+        CHECK(terminated.empty());
+    }
+}
@@ -0,0 +1,150 @@
+/*****************************************************************************
+ * @file BoundedMpmcQueue_TEST.cpp
+ * @brief 有界无锁队列测试：容量向上取整为2的幂，满时拒绝或丢弃计数、空时出队失败，反复绕回保持先进先出；
+ *        多个提交线程并发入队、单消费者出队，不丢失、不重复，同一生产者保持顺序
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <thread>
+
+#include "BoundedMpmcQueue.hpp"
+
+using namespace track_project;
+using namespace track_project::trackmanager;
+
+namespace
+{
+    struct Item
+    {
+        std::uint32_t producer = 0;
+        std::uint32_t sequence = 0;
+    };
+}
+
+TEST_CASE("无锁队列：容量向上取整为2的幂，最小为2", "[BoundedMpmcQueue]")
+{
+    const std::vector<std::pair<size_t, size_t>> cases{{1, 2}, {2, 2}, {3, 4}, {4, 4}, {5, 8}, {63, 64}, {64, 64}, {65, 128}, {1000, 1024}};
+    for (const auto &[requested, expected] : cases)
+    {
+        BoundedMpmcQueue<int> queue(requested);
+        INFO("申请容量 " << requested);
+        CHECK(queue.capacity() == expected);
+
+        // 实际可容纳的元素数等于取整后的容量
+        size_t pushed = 0;
+        while (queue.try_push(static_cast<int>(pushed)))
+            pushed++;
+        CHECK(pushed == expected);
+        CHECK(queue.size_approx() == expected);
+    }
+}
+
+TEST_CASE("无锁队列：满时try_push返回false、push_or_drop丢弃计数，空时try_pop返回false，反复绕回保持先进先出", "[BoundedMpmcQueue]")
+{
+    BoundedMpmcQueue<int> queue(6); // 取整为8
+    REQUIRE(queue.capacity() == 8);
+    int item = -1;
+
+    // 1.空队列
+    CHECK_FALSE(queue.try_pop(item));
+    CHECK(item == -1);
+    CHECK(queue.size_approx() == 0);
+
+    // 2.写满后拒绝，内容不被覆盖
+    for (int i = 0; i < 8; ++i)
+    {
+        REQUIRE(queue.try_push(i));
+    }
+    CHECK_FALSE(queue.try_push(100));
+    queue.push_or_drop(101);
+    queue.push_or_drop(102);
+    CHECK(queue.dropped() == 2);
+    CHECK(queue.size_approx() == 8);
+
+    // 3.出队一个后恰好可再入队一个
+    REQUIRE(queue.try_pop(item));
+    CHECK(item == 0);
+    CHECK(queue.try_push(8));
+    CHECK_FALSE(queue.try_push(9));
+    for (int i = 1; i <= 8; ++i)
+    {
+        REQUIRE(queue.try_pop(item));
+        CHECK(item == i);
+    }
+    CHECK_FALSE(queue.try_pop(item));
+    CHECK(queue.size_approx() == 0);
+
+    // 4.不同批量交替入队出队，写入位置多次绕回，始终先进先出
+    int next_push = 0, next_pop = 0;
+    for (int round = 0; round < 200; ++round)
+    {
+        const int push_count = 1 + round % 8, pop_count = 1 + (round * 3) % 8;
+        for (int k = 0; k < push_count; ++k)
+        {
+            if (queue.try_push(next_push))
+                next_push++;
+            else
+                REQUIRE(queue.size_approx() == 8);
+        }
+        for (int k = 0; k < pop_count; ++k)
+        {
+            if (queue.try_pop(item))
+            {
+                REQUIRE(item == next_pop);
+                next_pop++;
+            }
+            else
+                REQUIRE(next_pop == next_push);
+        }
+    }
+    CHECK(next_pop > 8 * 10);
+    CHECK(queue.dropped() == 2);
+}
+
+TEST_CASE("无锁队列：4个生产者并发入队，单消费者按生产者内顺序收到全部元素", "[BoundedMpmcQueue]")
+{
+    constexpr std::uint32_t PRODUCERS = 4, ITEMS_PER_PRODUCER = 50000;
+    BoundedMpmcQueue<Item> queue(64); // 容量远小于总量，队列反复写满与绕回
+
+    std::vector<std::thread> producers;
+    for (std::uint32_t p = 0; p < PRODUCERS; ++p)
+    {
+        producers.emplace_back([&queue, p]
+                               {
+                                   for (std::uint32_t i = 0; i < ITEMS_PER_PRODUCER; ++i)
+                                   {
+                                       while (!queue.try_push(Item{p, i}))
+                                           std::this_thread::yield();
+                                   } });
+    }
+
+    std::vector<std::uint32_t> next(PRODUCERS, 0);
+    std::uint64_t received = 0, out_of_order = 0;
+    Item item;
+    while (received < std::uint64_t(PRODUCERS) * ITEMS_PER_PRODUCER)
+    {
+        if (!queue.try_pop(item))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        REQUIRE(item.producer < PRODUCERS);
+        out_of_order += (item.sequence != next[item.producer]);
+        next[item.producer] = item.sequence + 1;
+        received++;
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+
+    CHECK(out_of_order == 0);
+    CHECK(next == std::vector<std::uint32_t>(PRODUCERS, ITEMS_PER_PRODUCER));
+    CHECK_FALSE(queue.try_pop(item));
+    CHECK(queue.dropped() == 0);
+}
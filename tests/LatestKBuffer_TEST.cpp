@@ -0,0 +1,304 @@
+/*****************************************************************************
+ * @file LatestKBuffer_TEST.cpp
+ * @brief 滚动更新缓冲区测试：写入、覆盖、按逻辑顺序读取与更换外部存储，列存储特化与结构体版本结果一致
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "LatestKBuffer.hpp"
+#include "LatestKBufferSoA.hpp"
+
+using namespace track_project;
+using namespace track_project::trackmanager;
+
+namespace
+{
+    // 各字段均由序号决定，便于逐字段比对
+    TrackPoint numbered_point(int n)
+    {
+        TrackPoint point = test::make_point(100.0 + n, 20.0 + n, 1000 + n);
+        point.sog = 0.5 * n;
+        point.cog = n % 360;
+        point.is_associated = (n % 3 == 0);
+        return point;
+    }
+
+    void require_point(const TrackPoint &point, int n)
+    {
+        const TrackPoint expected = numbered_point(n);
+        REQUIRE(point.longitude == expected.longitude);
+        REQUIRE(point.latitude == expected.latitude);
+        REQUIRE(point.sog == expected.sog);
+        REQUIRE(point.cog == expected.cog);
+        REQUIRE(point.is_associated == expected.is_associated);
+        REQUIRE(point.time.milliseconds == expected.time.milliseconds);
+    }
+}
+
+TEST_CASE("列存储缓冲区：各列按缓存行对齐，写满后覆盖最旧点迹，逐点、拷贝与按列读取一致", "[LatestKBuffer]")
+{
+    constexpr size_t CAPACITY = 5;
+    TrackPointColumns columns(CAPACITY);
+    for (const void *column : {static_cast<const void *>(columns.longitudes()), static_cast<const void *>(columns.latitudes()),
+                               static_cast<const void *>(columns.sogs()), static_cast<const void *>(columns.cogs()),
+                               static_cast<const void *>(columns.times()), static_cast<const void *>(columns.associations())})
+    {
+        CHECK(reinterpret_cast<std::uintptr_t>(column) % TrackPointColumns::COLUMN_ALIGNMENT == 0);
+    }
+
+    // 1.未写满
+    for (int n = 0; n < 3; ++n)
+    {
+        columns.push(numbered_point(n));
+    }
+    REQUIRE(columns.size() == 3);
+    CHECK_FALSE(columns.full());
+    for (int n = 0; n < 3; ++n)
+    {
+        require_point(columns[n], n);
+    }
+
+    // 2.写入12个点迹，只保留最新5个，逻辑起点绕回
+    for (int n = 3; n < 12; ++n)
+    {
+        columns.push(numbered_point(n));
+    }
+    REQUIRE(columns.size() == CAPACITY);
+    CHECK(columns.full());
+    for (size_t i = 0; i < CAPACITY; ++i)
+    {
+        require_point(columns[i], static_cast<int>(7 + i));
+    }
+
+    std::vector<TrackPoint> copied(CAPACITY);
+    REQUIRE(columns.copy_to(copied.data(), CAPACITY) == CAPACITY);
+    for (size_t i = 0; i < CAPACITY; ++i)
+    {
+        require_point(copied[i], static_cast<int>(7 + i));
+    }
+
+    // 3.按列读取：两段均非空，合起来为逻辑顺序
+    const auto ring = columns.segments();
+    REQUIRE(ring.first_count > 0);
+    REQUIRE(ring.second_count > 0);
+    REQUIRE(ring.first_count + ring.second_count == CAPACITY);
+    std::vector<double> longitudes(CAPACITY), latitudes(CAPACITY);
+    REQUIRE(columns.copy_positions_to(longitudes.data(), latitudes.data(), CAPACITY) == CAPACITY);
+    for (size_t k = 0; k < CAPACITY; ++k)
+    {
+        const size_t pos = k < ring.first_count ? ring.first_offset + k : k - ring.first_count;
+        const TrackPoint expected = numbered_point(static_cast<int>(7 + k));
+        CHECK(columns.longitudes()[pos] == expected.longitude);
+        CHECK(columns.latitudes()[pos] == expected.latitude);
+        CHECK(columns.times()[pos].milliseconds == expected.time.milliseconds);
+        CHECK(columns.associations()[pos] == expected.is_associated);
+        CHECK(longitudes[k] == expected.longitude);
+        CHECK(latitudes[k] == expected.latitude);
+    }
+
+    // 4.定点修改与清空
+    columns[0] = numbered_point(100);
+    require_point(columns[0], 100);
+    require_point(columns[1], 8);
+    columns.clear();
+    CHECK(columns.empty());
+    CHECK(columns.copy_to(copied.data(), CAPACITY) == 0);
+}
+
+TEST_CASE("列存储缓冲区：与结构体版本写入相同序列后内容一致", "[LatestKBuffer]")
+{
+    constexpr size_t CAPACITY = 7;
+    LatestKBuffer<TrackPoint> rows(CAPACITY);
+    TrackPointColumns columns(CAPACITY);
+    for (int n = 0; n < 40; ++n)
+    {
+        rows.push(numbered_point(n));
+        columns.push(numbered_point(n));
+        REQUIRE(columns.size() == rows.size());
+        REQUIRE(columns.full() == rows.full());
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            const TrackPoint point = columns[i];
+            REQUIRE(point.longitude == rows[i].longitude);
+            REQUIRE(point.time.milliseconds == rows[i].time.milliseconds);
+        }
+    }
+}
+
+TEST_CASE("批量写入：push_n跨越物理末尾时分两段写入，结果与逐个push一致", "[LatestKBuffer]")
+{
+    constexpr size_t CAPACITY = 8;
+    LatestKBuffer<int> bulk(CAPACITY), single(CAPACITY);
+    std::vector<int> items(40);
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        items[i] = static_cast<int>(i);
+    }
+
+    // 每批长度不同，写入位置在物理末尾前后反复绕回
+    size_t offset = 0;
+    for (size_t count : {3, 5, 6, 1, 7, 2})
+    {
+        bulk.push_n(items.data() + offset, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            single.push(items[offset + i]);
+        }
+        offset += count;
+
+        REQUIRE(bulk.size() == single.size());
+        REQUIRE(bulk.full() == single.full());
+        REQUIRE(bulk.write_position() - bulk.storage() == single.write_position() - single.storage());
+        for (size_t i = 0; i < single.size(); ++i)
+        {
+            REQUIRE(bulk[i] == single[i]);
+        }
+    }
+    CHECK(bulk.size() == CAPACITY);
+
+    // 空批次与空指针不改变内容
+    bulk.push_n(items.data(), 0);
+    bulk.push_n(nullptr, 3);
+    CHECK(bulk[0] == single[0]);
+    CHECK(bulk.size() == CAPACITY);
+}
+
+TEST_CASE("批量写入：push_n数量不小于容量时只保留最后capacity个", "[LatestKBuffer]")
+{
+    constexpr size_t CAPACITY = 8;
+    std::vector<int> items(20);
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        items[i] = static_cast<int>(100 + i);
+    }
+
+    for (size_t count : {CAPACITY, CAPACITY + 1, size_t(20)})
+    {
+        LatestKBuffer<int> buffer(CAPACITY);
+        buffer.push(-1);
+        buffer.push(-2);
+        buffer.push(-3); // 已有内容被整体覆盖
+        buffer.push_n(items.data(), count);
+
+        INFO("count " << count);
+        REQUIRE(buffer.size() == CAPACITY);
+        CHECK(buffer.full());
+        for (size_t i = 0; i < CAPACITY; ++i)
+        {
+            CHECK(buffer[i] == items[count - CAPACITY + i]);
+        }
+
+        // 之后的单个写入覆盖最旧元素
+        buffer.push(7);
+        CHECK(buffer[CAPACITY - 1] == 7);
+        CHECK(buffer[0] == items[count - CAPACITY + 1]);
+    }
+}
+
+TEST_CASE("只读视图：绕回后segments分两段，迭代器顺序与下标访问一致", "[LatestKBuffer]")
+{
+    constexpr size_t CAPACITY = 6;
+    LatestKBuffer<int> buffer(CAPACITY);
+
+    // 1.空缓冲区与未绕回时只有第一段
+    auto empty = buffer.segments();
+    CHECK(empty.first.empty());
+    CHECK(empty.second.empty());
+    CHECK(buffer.begin() == buffer.end());
+    for (int n = 0; n < 4; ++n)
+    {
+        buffer.push(n);
+    }
+    auto linear = buffer.segments();
+    CHECK(linear.first.size() == 4);
+    CHECK(linear.second.empty());
+    CHECK(linear.first.data() == buffer.storage());
+
+    // 2.写入10个后逻辑起点在物理位置4，两段分别为[4,6)与[0,4)
+    for (int n = 4; n < 10; ++n)
+    {
+        buffer.push(n);
+    }
+    auto wrapped = buffer.segments();
+    REQUIRE(wrapped.first.size() == 2);
+    REQUIRE(wrapped.second.size() == 4);
+    CHECK(wrapped.first.data() == buffer.storage() + 4);
+    CHECK(wrapped.second.data() == buffer.storage());
+    CHECK(buffer.write_position() == buffer.storage() + 4);
+
+    std::vector<int> from_segments;
+    for (const auto &segment : {wrapped.first, wrapped.second})
+    {
+        from_segments.insert(from_segments.end(), segment.begin(), segment.end());
+    }
+    CHECK(from_segments == std::vector<int>{4, 5, 6, 7, 8, 9});
+
+    // 3.迭代器与下标访问、STL算法
+    std::vector<int> from_iterators(buffer.begin(), buffer.end());
+    CHECK(from_iterators == from_segments);
+    REQUIRE(buffer.end() - buffer.begin() == static_cast<std::ptrdiff_t>(CAPACITY));
+    auto it = buffer.begin();
+    for (size_t i = 0; i < CAPACITY; ++i, ++it)
+    {
+        CHECK(*it == buffer[i]);
+        CHECK(buffer.begin()[static_cast<std::ptrdiff_t>(i)] == buffer[i]);
+    }
+    CHECK(it == buffer.end());
+    CHECK(*(buffer.end() - 1) == 9);
+    CHECK(std::find(buffer.begin(), buffer.end(), 7) - buffer.begin() == 3);
+    CHECK(std::is_sorted(buffer.begin(), buffer.end()));
+}
+
+TEST_CASE("外部存储：rebind按逻辑顺序搬迁到新存储，detach归还存储并清空", "[LatestKBuffer]")
+{
+    std::vector<int> small(4), large(10);
+    LatestKBuffer<int> buffer;
+    CHECK(buffer.capacity() == 0);
+
+    // 1.绑定小存储并写到绕回
+    buffer.rebind(small.data(), small.size());
+    CHECK(buffer.storage() == small.data());
+    for (int n = 0; n < 6; ++n)
+    {
+        buffer.push(n);
+    }
+    REQUIRE(buffer.segments().second.size() > 0);
+
+    // 2.换到大存储：内容按逻辑顺序放在起始处，只有一段，写入位置紧随其后
+    buffer.rebind(large.data(), large.size());
+    CHECK(buffer.storage() == large.data());
+    CHECK(buffer.capacity() == large.size());
+    CHECK(buffer.size() == 4);
+    CHECK_FALSE(buffer.full());
+    CHECK(std::vector<int>(large.begin(), large.begin() + 4) == std::vector<int>{2, 3, 4, 5});
+    CHECK(buffer.segments().second.empty());
+    CHECK(buffer.write_position() == large.data() + 4);
+    buffer.push(6);
+    CHECK(large[4] == 6);
+    CHECK(std::vector<int>(buffer.begin(), buffer.end()) == std::vector<int>{2, 3, 4, 5, 6});
+
+    // 3.数据量恰好等于新容量时为满
+    LatestKBuffer<int> exact;
+    std::vector<int> first(3), second(3);
+    exact.rebind(first.data(), first.size());
+    exact.push(1);
+    exact.push(2);
+    exact.push(3);
+    exact.rebind(second.data(), second.size());
+    CHECK(exact.full());
+    CHECK(exact.write_position() == second.data());
+
+    // 4.解除存储
+    CHECK(buffer.detach() == large.data());
+    CHECK(buffer.storage() == nullptr);
+    CHECK(buffer.capacity() == 0);
+    CHECK(buffer.empty());
+}
@@ -0,0 +1,269 @@
+/*****************************************************************************
+ * @file ManagementService_TEST.cpp
+ * @brief 管理服务测试：积压ADD指令合并后同一航迹点迹顺序不变，终结航迹的后续点迹被跳过；
+ *        快照发布失败后自动重试，只有DRAW指令时不发布；静默超时不大于0时不启用老化；
+ *        右值提交后调用方拿回回收的空缓冲区
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#include "ManagementService.hpp"
+
+using namespace track_project;
+
+namespace
+{
+    using Update = std::pair<TrackerHeader, TrackPoint>;
+
+    // 等待条件成立，超时返回false
+    template <typename Predicate>
+    bool wait_until(Predicate &&predicate, int timeout_ms = 5000)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (!predicate())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    // 点迹以纬度编号，用于核对顺序
+    Update update(std::uint32_t track_id, double sequence, bool associated = true)
+    {
+        TrackerHeader header;
+        header.track_id = track_id;
+        TrackPoint point = test::make_point(120.0, sequence);
+        point.is_associated = associated;
+        return {header, point};
+    }
+
+    // 创建count条航迹，起始点迹纬度为0~3，返回按创建顺序的航迹ID
+    std::vector<std::uint32_t> create_tracks(ManagementService &service, size_t count)
+    {
+        std::vector<std::array<TrackPoint, 4>> tracks(count);
+        for (auto &track : tracks)
+        {
+            for (int i = 0; i < 4; ++i)
+                track[i] = test::make_point(120.0, i);
+        }
+        service.create_track_command(std::move(tracks));
+
+        std::vector<std::uint32_t> ids;
+        TrackEvent event;
+        wait_until([&]
+                   {
+                       while (service.poll_track_event(event))
+                       {
+                           if (event.type == TrackEventType::INITIATED)
+                               ids.push_back(event.track_id);
+                       }
+                       return ids.size() == count; });
+        return ids;
+    }
+
+    std::vector<double> read_sequence(const ManagementService &service, std::uint32_t track_id)
+    {
+        auto session = service.read_session();
+        TrackerHeader header;
+        std::vector<TrackPoint> points;
+        std::vector<double> sequence;
+        if (!session.read_track(track_id, header, points))
+            return sequence;
+        for (const TrackPoint &point : points)
+            sequence.push_back(point.latitude);
+        return sequence;
+    }
+}
+
+TEST_CASE("指令合并：交错的多条ADD指令合并后同一航迹保持提交顺序", "[ManagementService]")
+{
+    ManagementService service(64, 64, 256, 60000, "", 0);
+    const std::vector<std::uint32_t> ids = create_tracks(service, 3);
+    REQUIRE(ids.size() == 3);
+    const std::uint32_t a = ids[0], b = ids[1], c = ids[2];
+
+    // 暂停后提交，四条指令在队列中积压，恢复后合并为一批
+    // 航迹c连续收到未关联点迹：第4个置为终结，第5个写入时被删除，其后的点迹被跳过
+    service.pause_processing();
+    service.add_track_command(std::vector<Update>{update(a, 10), update(b, 10), update(c, 10, false), update(a, 11)});
+    service.add_track_command(std::vector<Update>{update(b, 11), update(c, 11, false), update(a, 12), update(c, 12, false)});
+    service.add_track_command(std::vector<Update>{update(c, 13, false), update(a, 13), update(c, 14, false), update(b, 12), update(c, 15, false)});
+    service.add_track_command(std::vector<Update>{update(a, 14), update(c, 16, false), update(b, 13)});
+    service.resume_processing();
+
+    REQUIRE(wait_until([&]
+                       { return service.get_coalescing_stats().add_commands == 4; }));
+    service.pause_processing(); // 返回时本轮批量写入已完成
+    service.resume_processing();
+
+    CHECK(read_sequence(service, a) == std::vector<double>{0, 1, 2, 3, 10, 11, 12, 13, 14});
+    CHECK(read_sequence(service, b) == std::vector<double>{0, 1, 2, 3, 10, 11, 12, 13});
+    CHECK(read_sequence(service, c).empty());
+    TrackerHeader header;
+    CHECK_FALSE(service.read_session().read_header(c, header));
+
+    // 航迹c的删除事件携带终结状态与写入的最后一个点迹
+    bool c_deleted = false;
+    TrackEvent event;
+    while (service.poll_track_event(event))
+    {
+        if (event.type == TrackEventType::DELETED && event.track_id == c)
+        {
+            c_deleted = true;
+            CHECK(event.state == 2);
+            CHECK(event.latitude == 14);
+        }
+    }
+    CHECK(c_deleted);
+
+    // 16条点迹分属3条航迹，合并为一批，13条并入已解析的航迹
+    const auto stats = service.get_coalescing_stats();
+    CHECK(stats.add_commands == 4);
+    CHECK(stats.add_batches == 1);
+    CHECK(stats.add_updates_grouped == 16 - 3);
+    CHECK(stats.draw_commands == 0);
+}
+
+TEST_CASE("指令合并：未积压时每条ADD指令单独写入", "[ManagementService]")
+{
+    ManagementService service(64, 64, 256, 60000, "", 0);
+    const std::vector<std::uint32_t> ids = create_tracks(service, 1);
+    REQUIRE(ids.size() == 1);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        service.add_track_command(std::vector<Update>{update(ids[0], 10 + i), update(ids[0], 20 + i)});
+        REQUIRE(wait_until([&]
+                           { return service.get_coalescing_stats().add_commands == std::uint64_t(i + 1); }));
+        service.pause_processing();
+        service.resume_processing();
+    }
+
+    CHECK(read_sequence(service, ids[0]) == std::vector<double>{0, 1, 2, 3, 10, 20, 11, 21, 12, 22});
+    const auto stats = service.get_coalescing_stats();
+    CHECK(stats.add_batches == 3);
+    CHECK(stats.add_updates_grouped == 3);
+}
+
+TEST_CASE("快照发布：备用缓冲区均被持有时发布失败，释放后无新指令也会重试发布", "[ManagementService]")
+{
+    ManagementService service(64, 64, 256, 60000, "", 0);
+    auto sequence = [&]
+    { return service.acquire_snapshot()->sequence; };
+
+    // 依次持有三个缓冲区上的快照
+    std::optional<trackmanager::TrackSnapshotPublisher::Handle> oldest(service.acquire_snapshot());
+    REQUIRE(create_tracks(service, 1).size() == 1);
+    REQUIRE(wait_until([&]
+                       { return sequence() > (*oldest)->sequence; }));
+    auto middle = service.acquire_snapshot();
+    REQUIRE(create_tracks(service, 1).size() == 1);
+    REQUIRE(wait_until([&]
+                       { return sequence() > middle->sequence; }));
+    auto newest = service.acquire_snapshot();
+    REQUIRE(newest->size() == 2);
+
+    // 第三条航迹写入后无缓冲区可用，快照停留在旧版本
+    REQUIRE(create_tracks(service, 1).size() == 1);
+    service.pause_processing();
+    service.resume_processing();
+    CHECK(sequence() == newest->sequence);
+    CHECK(service.acquire_snapshot()->size() == 2);
+
+    // 释放最旧的快照，不再提交指令，工作线程在重试周期内补发
+    oldest.reset();
+    REQUIRE(wait_until([&]
+                       { return sequence() > newest->sequence; }, 500));
+    CHECK(service.acquire_snapshot()->size() == 3);
+}
+
+TEST_CASE("快照发布：只有DRAW指令时不发布新快照", "[ManagementService]")
+{
+    ManagementService service(64, 64, 256, 60000, "", 0);
+    REQUIRE(create_tracks(service, 1).size() == 1);
+    service.pause_processing();
+    service.resume_processing();
+    const std::uint64_t before = service.acquire_snapshot()->sequence;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        service.draw_point_command(std::vector<TrackPoint>{test::make_point(120.0, 30.0)});
+        REQUIRE(wait_until([&]
+                           { return service.get_coalescing_stats().draw_commands == std::uint64_t(i + 1); }));
+        service.pause_processing();
+        service.resume_processing();
+    }
+    CHECK(service.acquire_snapshot()->sequence == before);
+}
+
+TEST_CASE("指令提交：右值重载移入数据，调用方拿回回收的空缓冲区并保留其容量", "[ManagementService]")
+{
+    ManagementService service(64, 64, 256, 0, "", 0);
+    const std::vector<std::uint32_t> ids = create_tracks(service, 1);
+    REQUIRE(ids.size() == 1);
+    const std::uint32_t id = ids[0];
+
+    // 1.首次提交：池中没有回收对象，调用方拿回新建的空缓冲区，原缓冲区随指令交给工作线程
+    std::vector<Update> batch;
+    batch.reserve(100);
+    for (int i = 0; i < 3; ++i)
+        batch.push_back(update(id, 10 + i));
+    const Update *submitted = batch.data();
+    service.add_track_command(std::move(batch));
+    CHECK(batch.empty());
+    CHECK(batch.data() != submitted);
+    CHECK(batch.capacity() == 0);
+
+    // 工作线程处理完后指令数据对象清空归还，暂停返回时本轮已结束
+    REQUIRE(wait_until([&]
+                       { return service.get_coalescing_stats().add_commands == 1; }));
+    service.pause_processing();
+    service.resume_processing();
+    CHECK(read_sequence(service, id) == std::vector<double>{0, 1, 2, 3, 10, 11, 12});
+
+    // 2.再次提交：调用方拿回的正是上一批提交的缓冲区，已清空且容量保留，可直接填写下一批
+    batch.push_back(update(id, 20));
+    service.add_track_command(std::move(batch));
+    CHECK(batch.data() == submitted);
+    CHECK(batch.empty());
+    CHECK(batch.capacity() >= 100);
+
+    batch.push_back(update(id, 21));
+    service.add_track_command(std::move(batch));
+    REQUIRE(wait_until([&]
+                       { return service.get_coalescing_stats().add_commands == 3; }));
+    service.pause_processing();
+    service.resume_processing();
+    CHECK(read_sequence(service, id) == std::vector<double>{0, 1, 2, 3, 10, 11, 12, 20, 21});
+
+    // 3.左值重载拷贝，调用方的数据不变
+    std::vector<Update> kept{update(id, 30)};
+    service.add_track_command(kept);
+    REQUIRE(kept.size() == 1);
+    CHECK(kept[0].second.latitude == 30);
+}
+
+TEST_CASE("静默老化：静默超时不大于0时不启用老化", "[ManagementService]")
+{
+    for (std::int64_t timeout : {std::int64_t(0), std::int64_t(-1), std::int64_t(60000)})
+    {
+        ManagementService service(64, 64, 256, timeout, "", 0);
+        REQUIRE(create_tracks(service, 2).size() == 2);
+        service.pause_processing(); // 暂停期间航迹管理器不被修改，可直接读取
+        const auto &manager = service.get_tracker_manager();
+        INFO("静默超时 " << timeout);
+        CHECK(manager.is_aging_enabled() == (timeout > 0));
+        CHECK(manager.get_aging_entry_count() == (timeout > 0 ? 2u : 0u));
+        service.resume_processing();
+    }
+}
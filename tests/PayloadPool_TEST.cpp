@@ -0,0 +1,90 @@
+/*****************************************************************************
+ * @file PayloadPool_TEST.cpp
+ * @brief 指令数据对象池测试：归还的对象清空后保留容量被复用，池空时新建，空闲队列已满时多余对象被释放
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <set>
+
+#include "PayloadPool.hpp"
+
+using namespace track_project::trackmanager;
+
+TEST_CASE("对象池：归还的对象清空后保留容量，再次取出时复用", "[PayloadPool]")
+{
+    PayloadPool<int> pool(4);
+
+    // 1.池空时新建
+    auto *payload = pool.acquire();
+    REQUIRE(payload != nullptr);
+    CHECK(payload->empty());
+    CHECK(payload->capacity() == 0);
+
+    // 2.归还后清空但容量保留，取出的是同一对象
+    payload->assign(1000, 7);
+    const size_t capacity = payload->capacity();
+    pool.release(payload);
+    CHECK(payload->empty());
+    auto *reused = pool.acquire();
+    CHECK(reused == payload);
+    CHECK(reused->empty());
+    CHECK(reused->capacity() == capacity);
+
+    // 3.多个对象先进先出复用
+    auto *second = pool.acquire();
+    REQUIRE(second != reused);
+    pool.release(reused);
+    pool.release(second);
+    CHECK(pool.acquire() == reused);
+    CHECK(pool.acquire() == second);
+
+    pool.release(nullptr); // 空指针忽略
+    CHECK(pool.acquire()->capacity() == 0);
+}
+
+TEST_CASE("对象池：同时在用的对象多于池容量时照常新建，归还时只缓存池容量个，其余释放", "[PayloadPool]")
+{
+    constexpr size_t POOL_CAPACITY = 4;
+    constexpr size_t IN_FLIGHT = 10;
+    PayloadPool<int> pool(POOL_CAPACITY);
+
+    // 1.取出多于池容量的对象，均为不同的新对象；各自写入使容量非零以便区分复用
+    std::vector<PayloadPool<int>::Payload *> payloads;
+    for (size_t i = 0; i < IN_FLIGHT; ++i)
+    {
+        payloads.push_back(pool.acquire());
+        payloads.back()->assign(100 + i, 1);
+    }
+    CHECK(std::set<PayloadPool<int>::Payload *>(payloads.begin(), payloads.end()).size() == IN_FLIGHT);
+
+    // 2.全部归还：前POOL_CAPACITY个进入空闲队列，其余直接释放
+    for (auto *payload : payloads)
+    {
+        pool.release(payload);
+    }
+
+    // 3.再取出时前POOL_CAPACITY个为缓存的对象（容量保留），之后为新建的空对象
+    for (size_t i = 0; i < POOL_CAPACITY; ++i)
+    {
+        auto *payload = pool.acquire();
+        INFO("第" << i << "个");
+        CHECK(payload == payloads[i]);
+        CHECK(payload->empty());
+        CHECK(payload->capacity() >= 100 + i);
+        payloads[i] = payload;
+    }
+    auto *fresh = pool.acquire();
+    CHECK(fresh->capacity() == 0);
+
+    // 4.归还全部取出的对象，析构时释放缓存的对象
+    for (size_t i = 0; i < POOL_CAPACITY; ++i)
+    {
+        pool.release(payloads[i]);
+    }
+    pool.release(fresh);
+}
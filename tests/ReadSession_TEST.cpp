@@ -0,0 +1,230 @@
+/*****************************************************************************
+ * @file ReadSession_TEST.cpp
+ * @brief 只读会话并发压力测试：一个写入线程反复创建、写入（含存储搬迁）、删除、清空与收缩，
+ *        多个读取线程同时读取，读到的航迹头与点迹必须是同一时刻的完整内容
+ * 配置时打开 TRACKMANAGER_ENABLE_TSAN 可在ThreadSanitizer下运行，按序号校验的读取见TrackerManager::read_track的标注
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+#include "TrackerManager.hpp"
+
+using namespace track_project;
+using namespace track_project::trackmanager;
+
+namespace
+{
+    // 点迹经度为航迹ID，纬度为该航迹内的写入序号，读取方据此判断读到的内容是否完整
+    TrackPoint encode(std::uint32_t track_id, std::uint32_t sequence)
+    {
+        return test::make_point(static_cast<double>(track_id), static_cast<double>(sequence), 1000);
+    }
+
+    struct ReaderStats
+    {
+        std::atomic<std::uint64_t> tracks{0};   // 读到的航迹数
+        std::atomic<std::uint64_t> points{0};   // 读到的点迹数
+        std::atomic<std::uint64_t> torn{0};     // 不完整或不一致的读取
+        std::atomic<std::uint64_t> sessions{0}; // 有效会话数
+    };
+
+    void reader_loop(const TrackerManager &manager, const std::atomic<bool> &stop, ReaderStats &stats)
+    {
+        std::vector<std::uint32_t> ids;
+        std::vector<TrackPoint> points;
+        TrackerHeader header;
+        TrackPoint latest;
+        while (!stop.load(std::memory_order_acquire))
+        {
+            auto session = manager.read_session();
+            if (!session.valid())
+                continue;
+            stats.sessions.fetch_add(1, std::memory_order_relaxed);
+            session.read_active_ids(ids);
+            for (std::uint32_t track_id : ids)
+            {
+                if (session.read_track(track_id, header, points))
+                {
+                    bool consistent = header.track_id == track_id && header.point_num == points.size();
+                    for (size_t i = 0; consistent && i < points.size(); ++i)
+                    {
+                        consistent = points[i].longitude == static_cast<double>(track_id) &&
+                                     (i == 0 || points[i].latitude == points[i - 1].latitude + 1.0);
+                    }
+                    stats.torn.fetch_add(consistent ? 0 : 1, std::memory_order_relaxed);
+                    stats.tracks.fetch_add(1, std::memory_order_relaxed);
+                    stats.points.fetch_add(points.size(), std::memory_order_relaxed);
+                }
+                if (session.read_latest(track_id, latest) && latest.longitude != static_cast<double>(track_id))
+                {
+                    stats.torn.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("只读会话：多个读取线程与写入线程的创建、搬迁、删除、清空、收缩并发", "[ReadSession]")
+{
+    // 初始64条、按256条一块扩容到1024条；点迹存储32 -> 128 -> 512三级
+    TrackerManager manager(64, 512, false, 1024);
+    std::atomic<bool> stop{false};
+    ReaderStats stats;
+
+    constexpr int READER_COUNT = 3;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < READER_COUNT; ++i)
+    {
+        readers.emplace_back(reader_loop, std::cref(manager), std::cref(stop), std::ref(stats));
+    }
+
+    // 写入线程：活跃航迹数在50与600之间交替，跨块扩容后再收缩
+    std::mt19937 rng(20251215);
+    std::unordered_map<std::uint32_t, std::uint32_t> next_sequence;
+    std::vector<std::uint32_t> live;
+    size_t created = 0, promoted_points = 0, clears = 0, shrinks = 0;
+    auto push = [&](std::uint32_t track_id, std::uint32_t count)
+    {
+        for (std::uint32_t k = 0; k < count; ++k)
+        {
+            REQUIRE(manager.push_track_point(track_id, encode(track_id, next_sequence[track_id]++)));
+        }
+    };
+    auto erase_live = [&](size_t index)
+    {
+        next_sequence.erase(live[index]);
+        live[index] = live.back();
+        live.pop_back();
+    };
+
+    constexpr int OPERATIONS = 60000;
+    for (int op = 0; op < OPERATIONS; ++op)
+    {
+        const size_t target = (op / 5000) % 2 ? 600 : 50;
+        const std::uint32_t dice = rng() % 1000;
+        if (dice < 2)
+        {
+            manager.clear_all();
+            live.clear();
+            next_sequence.clear();
+            clears++;
+        }
+        else if (dice < 10)
+        {
+            manager.shrink_to_fit();
+            shrinks++;
+        }
+        else if (live.size() < target && dice < 400)
+        {
+            std::uint32_t track_id = manager.create_track();
+            REQUIRE(track_id != 0);
+            live.push_back(track_id);
+            push(track_id, 1 + rng() % 3);
+            created++;
+        }
+        else if (!live.empty() && (live.size() > target ? dice < 600 : dice < 480))
+        {
+            const size_t index = rng() % live.size();
+            REQUIRE(manager.delete_track(live[index]));
+            erase_live(index);
+        }
+        else if (!live.empty())
+        {
+            const std::uint32_t track_id = live[rng() % live.size()];
+            const std::uint32_t before = next_sequence[track_id];
+            push(track_id, 1 + rng() % 40);
+            promoted_points += (before < 32 && next_sequence[track_id] >= 32) || (before < 128 && next_sequence[track_id] >= 128);
+        }
+        manager.reclaim_chunks();
+    }
+
+    stop.store(true, std::memory_order_release);
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    INFO("创建" << created << " 搬迁" << promoted_points << " 清空" << clears << " 收缩" << shrinks
+                << " 读取航迹" << stats.tracks.load() << " 点迹" << stats.points.load());
+    CHECK(stats.torn.load() == 0);
+    CHECK(stats.sessions.load() > 0);
+    CHECK(stats.tracks.load() > 0);
+    CHECK(promoted_points > 0);
+    CHECK(clears > 0);
+    CHECK(shrinks > 0);
+
+    // 写入线程停止后管理器状态与写入记录一致
+    manager.reclaim_chunks();
+    CHECK(manager.get_used_count() == live.size());
+}
+
+TEST_CASE("只读会话：会话持有期间删除的槽位立即复用，反复创建删除不会耗尽容量上限", "[ReadSession]")
+{
+    TrackerManager manager(8, 32, false, 8);
+    auto session = manager.read_session();
+    REQUIRE(session.valid());
+
+    TrackerHeader header;
+    std::vector<TrackPoint> points;
+    for (int round = 0; round < 100; ++round)
+    {
+        std::uint32_t track_id = manager.create_track();
+        REQUIRE(track_id != 0);
+        REQUIRE(manager.push_track_point(track_id, encode(track_id, 0)));
+        REQUIRE(session.read_track(track_id, header, points));
+        CHECK(points.size() == 1);
+
+        REQUIRE(manager.delete_track(track_id));
+        CHECK_FALSE(session.read_track(track_id, header, points));
+    }
+    CHECK(manager.get_total_capacity() == 8);
+}
+
+TEST_CASE("只读会话：会话持有期间收缩的块保留到会话结束，其间重新扩容复用", "[ReadSession]")
+{
+    TrackerManager manager(8, 32, false, 600);
+    std::vector<std::uint32_t> ids;
+    for (int i = 0; i < 300; ++i)
+    {
+        ids.push_back(manager.create_track());
+        REQUIRE(ids.back() != 0);
+    }
+    const std::uint32_t kept = ids.front();
+    REQUIRE(manager.push_track_point(kept, encode(kept, 0)));
+
+    {
+        auto session = manager.read_session();
+        for (size_t i = 1; i < ids.size(); ++i)
+        {
+            REQUIRE(manager.delete_track(ids[i]));
+        }
+        manager.shrink_to_fit();
+        CHECK(manager.get_total_capacity() == 256);
+
+        // 收缩后重新扩容，复用尚未释放的块
+        for (int i = 0; i < 300; ++i)
+        {
+            REQUIRE(manager.create_track() != 0);
+        }
+        CHECK(manager.get_total_capacity() == 512);
+
+        TrackPoint latest;
+        REQUIRE(session.read_latest(kept, latest));
+        CHECK(latest.longitude == static_cast<double>(kept));
+    }
+
+    // 会话结束后收缩，末尾的块释放
+    manager.clear_all();
+    manager.shrink_to_fit();
+    CHECK(manager.get_total_capacity() == 256);
+    CHECK(manager.create_track() != 0);
+}
@@ -0,0 +1,165 @@
+/*****************************************************************************
+ * @file RenderMailbox_TEST.cpp
+ * @brief 渲染帧信箱测试：只取最新帧，被取代的点迹帧如实计数；清空先于其后投递的点迹帧执行，
+ *        被取代的清空由后续帧补上；工作线程与渲染线程并发时顺序不变、点迹帧不丢不重
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "RenderMailbox.hpp"
+
+using namespace track_project;
+using namespace track_project::trackmanager;
+
+namespace
+{
+    // 帧内容：经度为帧序号
+    std::vector<TrackPoint> frame(int id, size_t count = 1)
+    {
+        return std::vector<TrackPoint>(count, test::make_point(static_cast<double>(id), 0.0));
+    }
+
+    // 单线程取走一帧，按回调顺序记录："C"为清空，数字为绘制的帧序号
+    std::string take(RenderMailbox &mailbox)
+    {
+        std::string log;
+        if (!mailbox.take([&]
+                          { log += "C"; },
+                          [&](const std::vector<TrackPoint> &points)
+                          { log += std::to_string(static_cast<int>(points.front().longitude)); }))
+            return "-";
+        return log;
+    }
+}
+
+TEST_CASE("渲染帧信箱：只取最新帧，清空先于其后的点迹帧，被取代的清空由后续帧补上", "[RenderMailbox]")
+{
+    RenderMailbox mailbox;
+    CHECK(take(mailbox) == "-");
+
+    // 1.单个点迹帧取走一次
+    auto points = frame(1);
+    CHECK_FALSE(mailbox.post_points(points));
+    CHECK(take(mailbox) == "1");
+    CHECK(take(mailbox) == "-");
+
+    // 2.清空后投递点迹帧：点迹帧取代清空帧但不计数，渲染线程先清空再绘制
+    CHECK_FALSE(mailbox.post_clear());
+    points = frame(2);
+    CHECK_FALSE(mailbox.post_points(points));
+    CHECK(take(mailbox) == "C2");
+
+    // 3.连续两个点迹帧：前一帧被取代并计数，只绘制最新帧
+    points = frame(3);
+    CHECK_FALSE(mailbox.post_points(points));
+    points = frame(4);
+    CHECK(mailbox.post_points(points));
+    CHECK(take(mailbox) == "4");
+
+    // 4.点迹帧后清空：点迹帧被取代，只清空
+    points = frame(5);
+    CHECK_FALSE(mailbox.post_points(points));
+    CHECK(mailbox.post_clear());
+    CHECK(take(mailbox) == "C");
+
+    // 5.连续两次清空只执行一次；已取走的清空不重复执行
+    CHECK_FALSE(mailbox.post_clear());
+    CHECK_FALSE(mailbox.post_clear());
+    CHECK(take(mailbox) == "C");
+    points = frame(6);
+    CHECK_FALSE(mailbox.post_points(points));
+    CHECK(take(mailbox) == "6");
+}
+
+TEST_CASE("渲染帧信箱：投递时换回工作线程所持旧帧的缓冲区，三帧轮换后容量复用", "[RenderMailbox]")
+{
+    RenderMailbox mailbox;
+    std::vector<std::vector<TrackPoint>> returned;
+    for (int id = 1; id <= 6; ++id)
+    {
+        auto points = frame(id, 10 * id);
+        const TrackPoint *data = points.data();
+        mailbox.post_points(points);
+        CHECK(points.data() != data); // 缓冲区已交给信箱
+        returned.push_back(std::move(points));
+        CHECK(take(mailbox) == std::to_string(id));
+    }
+
+    // 前三次换回三个初始空帧，之后换回的是此前投递且已绘制的帧
+    CHECK(returned[0].empty());
+    CHECK(returned[1].empty());
+    CHECK(returned[2].empty());
+    for (size_t i = 3; i < returned.size(); ++i)
+    {
+        INFO("第" << i + 1 << "次投递");
+        REQUIRE_FALSE(returned[i].empty());
+        CHECK(returned[i].front().longitude < static_cast<double>(i + 1));
+    }
+}
+
+TEST_CASE("渲染帧信箱：工作线程与渲染线程并发时帧序号递增，清空只在清空代数变化时执行且先于绘制", "[RenderMailbox]")
+{
+    // 点迹帧的纬度记录投递时的清空代数，渲染线程据此核对清空与绘制的先后
+    RenderMailbox mailbox;
+    constexpr int FRAMES = 20000;
+    std::atomic<bool> done{false};
+    int superseded = 0;
+
+    std::thread worker([&]
+                       {
+                           int generation = 0;
+                           for (int id = 1; id <= FRAMES; ++id)
+                           {
+                               if (id % 7 == 0)
+                               {
+                                   superseded += mailbox.post_clear();
+                                   generation++;
+                               }
+                               auto points = frame(id);
+                               points.front().latitude = generation;
+                               superseded += mailbox.post_points(points);
+                               if (id % 64 == 0)
+                                   std::this_thread::yield();
+                           }
+                           done.store(true, std::memory_order_release); });
+
+    int drawn = 0, last_id = 0, bad_order = 0;
+    double last_generation = 0;
+    bool cleared_since_draw = false;
+    auto take_one = [&]
+    {
+        return mailbox.take([&]
+                            { cleared_since_draw = true; },
+                            [&](const std::vector<TrackPoint> &points)
+                            {
+                                const int id = static_cast<int>(points.front().longitude);
+                                const double generation = points.front().latitude;
+                                // 帧序号递增；代数变化当且仅当其间执行过清空
+                                bad_order += (id <= last_id);
+                                bad_order += ((generation != last_generation) != cleared_since_draw);
+                                last_id = id;
+                                last_generation = generation;
+                                cleared_since_draw = false;
+                                drawn++; });
+    };
+    while (!done.load(std::memory_order_acquire))
+    {
+        if (!take_one())
+            std::this_thread::yield();
+    }
+    worker.join();
+    take_one(); // 最后一帧
+
+    CHECK(bad_order == 0);
+    CHECK(last_id == FRAMES);
+    CHECK(drawn + superseded == FRAMES);
+    CHECK(drawn > 0);
+}
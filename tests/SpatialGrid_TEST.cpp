@@ -0,0 +1,224 @@
+/*****************************************************************************
+ * @file SpatialGrid_TEST.cpp
+ * @brief 网格索引测试：圆形与矩形查询在网格边界、负坐标下与逐个计算一致，非有限值与超范围坐标不越界
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "SpatialGrid.hpp"
+
+using namespace track_project::trackmanager;
+
+namespace
+{
+    constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+    constexpr double M = SpatialGrid::METERS_PER_DEGREE;
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+    struct Position
+    {
+        double longitude;
+        double latitude;
+    };
+
+    std::vector<std::uint32_t> sorted(std::vector<std::uint32_t> ids)
+    {
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    // 槽位号即航迹ID
+    void fill(SpatialGrid &grid, const std::vector<Position> &positions)
+    {
+        for (std::uint32_t i = 0; i < positions.size(); ++i)
+        {
+            grid.update(i, i, positions[i].longitude, positions[i].latitude);
+        }
+    }
+
+    std::vector<std::uint32_t> box_brute_force(const std::vector<Position> &positions,
+                                               double min_lon, double min_lat, double max_lon, double max_lat)
+    {
+        std::vector<std::uint32_t> ids;
+        for (std::uint32_t i = 0; i < positions.size(); ++i)
+        {
+            const Position &p = positions[i];
+            if (p.longitude >= min_lon && p.longitude <= max_lon && p.latitude >= min_lat && p.latitude <= max_lat)
+                ids.push_back(i);
+        }
+        return ids;
+    }
+
+    // 与SpatialGrid::query_radius相同的局部等距投影
+    std::vector<std::uint32_t> radius_brute_force(const std::vector<Position> &positions,
+                                                  double longitude, double latitude, double radius_m)
+    {
+        const double meters_per_lon = M * std::max(std::cos(latitude * DEG_TO_RAD), 1e-6);
+        std::vector<std::uint32_t> ids;
+        for (std::uint32_t i = 0; i < positions.size(); ++i)
+        {
+            const double dx = (positions[i].longitude - longitude) * meters_per_lon;
+            const double dy = (positions[i].latitude - latitude) * M;
+            if (dx * dx + dy * dy <= radius_m * radius_m)
+                ids.push_back(i);
+        }
+        return ids;
+    }
+
+    // 坐标取网格边长0.5度的整数倍及其附近，负坐标与零两侧各占一半
+    std::vector<Position> boundary_positions(std::mt19937 &rng, size_t count)
+    {
+        std::uniform_int_distribution<int> step(-8, 8);
+        std::uniform_int_distribution<int> nudge(-1, 1);
+        std::vector<Position> positions;
+        for (size_t i = 0; i < count; ++i)
+        {
+            positions.push_back({step(rng) * 0.5 + nudge(rng) * 1e-9, step(rng) * 0.5 + nudge(rng) * 1e-9});
+        }
+        return positions;
+    }
+}
+
+TEST_CASE("网格索引：矩形查询边界落在网格线上与负坐标时结果与逐个判断一致", "[SpatialGrid]")
+{
+    // 1.网格线两侧与网格线上的点：-0.5度网格为[-1,-0.5)，0度网格为[0,0.5)
+    SpatialGrid half(8, 0.5);
+    const std::vector<Position> positions{{-0.5, -0.5}, {-0.5 - 1e-9, -0.5}, {0.0, 0.0}, {-1e-12, 0.0}, {0.5, 0.5}, {0.5 - 1e-12, -1.0}};
+    fill(half, positions);
+    REQUIRE(half.size() == positions.size());
+
+    std::vector<std::uint32_t> ids;
+    half.query_box(-0.5, -0.5, 0.0, 0.0, ids);
+    CHECK(sorted(ids) == std::vector<std::uint32_t>{0, 2, 3});
+    ids.clear();
+    half.query_box(-1.0, -1.0, -0.5 - 1e-10, 0.0, ids);
+    CHECK(ids == std::vector<std::uint32_t>{1});
+    ids.clear();
+    half.query_box(0.5, 0.5, 0.5, 0.5, ids); // 退化为一点
+    CHECK(ids == std::vector<std::uint32_t>{4});
+    ids.clear();
+    half.query_box(0.0, -1.0, 0.5, -1.0, ids);
+    CHECK(ids == std::vector<std::uint32_t>{5});
+
+    // 2.随机矩形，边界取网格线或其附近
+    std::mt19937 rng(12);
+    SpatialGrid random_grid(400, 0.5);
+    const std::vector<Position> many = boundary_positions(rng, 400);
+    fill(random_grid, many);
+    std::uniform_int_distribution<int> edge(-10, 10);
+    std::uniform_int_distribution<int> nudge(-1, 1);
+    for (int round = 0; round < 500; ++round)
+    {
+        double lon0 = edge(rng) * 0.5 + nudge(rng) * 1e-9, lon1 = edge(rng) * 0.5 + nudge(rng) * 1e-9;
+        double lat0 = edge(rng) * 0.5 + nudge(rng) * 1e-9, lat1 = edge(rng) * 0.5 + nudge(rng) * 1e-9;
+        ids.clear();
+        random_grid.query_box(std::min(lon0, lon1), std::min(lat0, lat1), std::max(lon0, lon1), std::max(lat0, lat1), ids);
+        INFO("矩形 " << lon0 << "," << lat0 << " " << lon1 << "," << lat1);
+        REQUIRE(sorted(ids) == box_brute_force(many, std::min(lon0, lon1), std::min(lat0, lat1), std::max(lon0, lon1), std::max(lat0, lat1)));
+    }
+
+    // 3.下界大于上界时无结果
+    ids.clear();
+    random_grid.query_box(1.0, 0.0, -1.0, 1.0, ids);
+    CHECK(ids.empty());
+}
+
+TEST_CASE("网格索引：圆形查询跨网格边界与负坐标时结果与逐个计算一致，移动与删除后同样一致", "[SpatialGrid]")
+{
+    std::mt19937 rng(34);
+    SpatialGrid grid(400, 0.5);
+    std::vector<Position> positions = boundary_positions(rng, 400);
+    fill(grid, positions);
+
+    std::uniform_int_distribution<int> center(-10, 10);
+    std::uniform_real_distribution<double> radius(0.0, 3.0 * M); // 最大约6个网格
+    std::uniform_int_distribution<std::uint32_t> pick(0, 399);
+    std::vector<std::uint32_t> ids;
+    for (int round = 0; round < 500; ++round)
+    {
+        // 每轮移动或删除一个槽位，同网格移动、跨网格移动与删除都会发生
+        const std::uint32_t slot = pick(rng);
+        if (round % 7 == 0)
+        {
+            grid.remove(slot);
+            positions[slot] = {1e6, 1e6}; // 暴力计算时远离全部查询
+        }
+        else
+        {
+            positions[slot] = boundary_positions(rng, 1).front();
+            grid.update(slot, slot, positions[slot].longitude, positions[slot].latitude);
+        }
+
+        const double longitude = center(rng) * 0.5, latitude = center(rng) * 0.25;
+        const double radius_m = round % 5 == 0 ? 0.5 * M : radius(rng); // 半径恰为半个网格时边界点迹在圆上
+        ids.clear();
+        grid.query_radius(longitude, latitude, radius_m, ids);
+        INFO("中心 " << longitude << "," << latitude << " 半径 " << radius_m);
+        REQUIRE(sorted(ids) == radius_brute_force(positions, longitude, latitude, radius_m));
+    }
+
+    // 半径为零只命中中心重合的点迹，负半径无结果
+    SpatialGrid single(2, 0.5);
+    single.update(0, 7, -0.5, -0.5);
+    single.update(1, 8, -0.5, -0.4);
+    ids.clear();
+    single.query_radius(-0.5, -0.5, 0.0, ids);
+    CHECK(ids == std::vector<std::uint32_t>{7});
+    ids.clear();
+    single.query_radius(-0.5, -0.5, -1.0, ids);
+    CHECK(ids.empty());
+}
+
+TEST_CASE("网格索引：非有限值与超出网格号范围的坐标、半径不越界", "[SpatialGrid]")
+{
+    // 网格边长极小，普通经纬度的网格号即超出int32范围
+    SpatialGrid grid(4, 1e-9);
+    grid.update(0, 10, 120.0, 30.0);
+    grid.update(1, 11, -120.0, -30.0);
+    grid.update(2, 12, 1e300, -1e300);
+    REQUIRE(grid.size() == 3);
+
+    // 1.非有限坐标移出索引
+    grid.update(3, 13, 0.0, 0.0);
+    REQUIRE(grid.size() == 4);
+    grid.update(3, 13, NaN, 0.0);
+    CHECK(grid.size() == 3);
+    grid.update(3, 13, 0.0, INF);
+    CHECK(grid.size() == 3);
+
+    // 2.超范围坐标钳位到边缘网格，精确判断仍按原始坐标
+    std::vector<std::uint32_t> ids;
+    grid.query_box(119.0, 29.0, 121.0, 31.0, ids);
+    CHECK(ids == std::vector<std::uint32_t>{10});
+    ids.clear();
+    grid.query_box(-121.0, -31.0, -119.0, -29.0, ids);
+    CHECK(ids == std::vector<std::uint32_t>{11});
+    ids.clear();
+    grid.query_radius(120.0, 30.0, 1000.0, ids);
+    CHECK(ids == std::vector<std::uint32_t>{10});
+
+    // 3.无穷边界与无穷半径覆盖全部，NaN边界、中心与半径无结果
+    ids.clear();
+    grid.query_box(-INF, -INF, INF, INF, ids);
+    CHECK(sorted(ids) == std::vector<std::uint32_t>{10, 11, 12});
+    ids.clear();
+    grid.query_radius(0.0, 0.0, INF, ids);
+    CHECK(sorted(ids) == std::vector<std::uint32_t>{10, 11, 12});
+    ids.clear();
+    grid.query_box(NaN, 0.0, 1.0, 1.0, ids);
+    grid.query_box(0.0, 0.0, 1.0, NaN, ids);
+    grid.query_radius(NaN, 30.0, 1000.0, ids);
+    grid.query_radius(120.0, INF, 1000.0, ids);
+    grid.query_radius(120.0, 30.0, NaN, ids);
+    CHECK(ids.empty());
+}
@@ -0,0 +1,39 @@
+/*****************************************************************************
+ * @file TestCommon.hpp
+ * @brief 测试公共头文件：Catch2 版本适配与常用辅助函数
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#ifndef _TEST_COMMON_HPP_
+#define _TEST_COMMON_HPP_
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+#include <set>
+#include <vector>
+#include <cstdint>
+
+#include "../include/defstruct.h"
+
+namespace track_project::test
+{
+    inline std::set<std::uint32_t> to_set(const std::vector<std::uint32_t> &ids) { return {ids.begin(), ids.end()}; }
+
+    // 已关联的点迹，写入后航迹保持正常状态；time_ms为0时使用当前时间
+    inline TrackPoint make_point(double longitude, double latitude, std::int64_t time_ms = 0)
+    {
+        TrackPoint point{};
+        point.longitude = longitude;
+        point.latitude = latitude;
+        point.is_associated = true;
+        if (time_ms != 0)
+            point.time.milliseconds = time_ms;
+        return point;
+    }
+}
+
+#endif // _TEST_COMMON_HPP_
@@ -0,0 +1,10 @@
+/*****************************************************************************
+ * @file TestMain.cpp
+ * @brief 测试程序入口，Catch2 v2 在此生成main，v3 由 Catch2WithMain 提供
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#if !__has_include(<catch2/catch_test_macros.hpp>)
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+#endif
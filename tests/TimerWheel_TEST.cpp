@@ -0,0 +1,211 @@
+/*****************************************************************************
+ * @file TimerWheel_TEST.cpp
+ * @brief 分层时间轮测试：跨256/64/64层边界的级联、刷新后重新挂入、到期与失效条目
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <map>
+#include <random>
+
+#include "TimerWheel.hpp"
+
+using namespace track_project;
+using namespace track_project::trackmanager;
+
+namespace
+{
+    // 模拟航迹管理器：槽位 -> 最后更新时刻，删除的槽位不在表中
+    struct FakeTracks
+    {
+        std::map<std::uint32_t, std::int64_t> last_update;
+        size_t refresh_calls = 0;
+
+        bool operator()(std::uint32_t slot, std::uint32_t track_id, std::int64_t &last_ms)
+        {
+            refresh_calls++;
+            auto it = last_update.find(slot);
+            if (it == last_update.end() || track_id != slot + 1)
+                return false;
+            last_ms = std::max(last_ms, it->second);
+            return true;
+        }
+    };
+
+    // 各层覆盖的刻度数：第0层256，第1层256*64，第2层256*64*64，第3层256*64*64*64
+    constexpr std::int64_t LEVEL0_SPAN = 256;
+    constexpr std::int64_t LEVEL1_SPAN = LEVEL0_SPAN * 64;
+    constexpr std::int64_t LEVEL2_SPAN = LEVEL1_SPAN * 64;
+    constexpr std::int64_t LEVEL3_SPAN = LEVEL2_SPAN * 64;
+}
+
+// 刻度1毫秒时到期判定是精确的：条目恰好在 last < now - timeout 的第一次推进中到期
+TEST_CASE("时间轮：跨各层边界的条目经级联后准时到期", "[TimerWheel]")
+{
+    const std::int64_t timeout = 10;
+    TimerWheel wheel(0, 1);
+    FakeTracks tracks;
+
+    // 最后更新时刻落在各层边界两侧，以及超出总跨度（截断到最远一格后再次挂入）
+    const std::vector<std::int64_t> times = {
+        0, 1, LEVEL0_SPAN - 1, LEVEL0_SPAN, LEVEL0_SPAN + 1,
+        LEVEL1_SPAN - 1, LEVEL1_SPAN, LEVEL1_SPAN + 1, 3 * LEVEL1_SPAN + 7,
+        LEVEL2_SPAN - 1, LEVEL2_SPAN, LEVEL2_SPAN + 1, 5 * LEVEL2_SPAN + 13,
+        LEVEL3_SPAN - 1, LEVEL3_SPAN + 1, 2 * LEVEL3_SPAN + 3};
+    for (std::uint32_t slot = 0; slot < times.size(); ++slot)
+    {
+        wheel.schedule(slot, slot + 1);
+        tracks.last_update[slot] = times[slot];
+    }
+    REQUIRE(wheel.size() == times.size());
+
+    // 每个边界附近逐毫秒推进，其余区间大步跳过
+    std::vector<std::int64_t> steps;
+    for (std::int64_t t : times)
+    {
+        for (std::int64_t d = -2; d <= 2; ++d)
+            steps.push_back(t + timeout + d);
+    }
+    std::sort(steps.begin(), steps.end());
+
+    std::map<std::uint32_t, std::int64_t> expired_at;
+    std::vector<std::uint32_t> expired;
+    for (std::int64_t now : steps)
+    {
+        wheel.advance(now, timeout, tracks, expired);
+        for (std::uint32_t track_id : expired)
+        {
+            REQUIRE(expired_at.count(track_id - 1) == 0);
+            expired_at[track_id - 1] = now;
+            tracks.last_update.erase(track_id - 1);
+        }
+        expired.clear();
+    }
+
+    REQUIRE(expired_at.size() == times.size());
+    for (std::uint32_t slot = 0; slot < times.size(); ++slot)
+    {
+        INFO("slot " << slot << " last " << times[slot]);
+        CHECK(expired_at[slot] == times[slot] + timeout + 1);
+    }
+    CHECK(wheel.size() == 0);
+}
+
+TEST_CASE("时间轮：持续更新的条目刷新后重新挂入，停止更新后到期", "[TimerWheel]")
+{
+    const std::int64_t timeout = 1000;
+    TimerWheel wheel(0, 10);
+    FakeTracks tracks;
+    wheel.schedule(0, 1);
+    wheel.schedule(1, 2);
+    tracks.last_update[0] = 0;
+    tracks.last_update[1] = 0;
+
+    // 槽位0每500毫秒更新一次，持续到第1层以外；槽位1从不更新
+    std::vector<std::uint32_t> expired;
+    std::int64_t now = 0;
+    bool slot1_expired = false;
+    for (; now <= 3 * LEVEL1_SPAN * 10; now += 500)
+    {
+        tracks.last_update[0] = now;
+        wheel.advance(now, timeout, tracks, expired);
+        for (std::uint32_t track_id : expired)
+        {
+            REQUIRE(track_id == 2);
+            REQUIRE(now > timeout);
+            slot1_expired = true;
+            tracks.last_update.erase(1);
+        }
+        expired.clear();
+    }
+    CHECK(slot1_expired);
+    CHECK(wheel.size() == 1);
+
+    // 停止更新后，超时加一个刻度内到期
+    const std::int64_t last = tracks.last_update[0];
+    for (now = last; expired.empty(); now += 10)
+    {
+        wheel.advance(now, timeout, tracks, expired);
+    }
+    CHECK(expired == std::vector<std::uint32_t>{1});
+    CHECK(now - 10 > last + timeout);
+    CHECK(now - 10 <= last + timeout + 2 * 10);
+    CHECK(wheel.size() == 0);
+}
+
+TEST_CASE("时间轮：删除或复用的槽位在到期时丢弃", "[TimerWheel]")
+{
+    TimerWheel wheel(0, 1);
+    FakeTracks tracks;
+    for (std::uint32_t slot = 0; slot < 100; ++slot)
+    {
+        wheel.schedule(slot, slot + 1);
+        tracks.last_update[slot] = 0;
+    }
+    for (std::uint32_t slot = 0; slot < 100; slot += 2)
+    {
+        tracks.last_update.erase(slot);
+    }
+
+    std::vector<std::uint32_t> expired;
+    wheel.advance(LEVEL1_SPAN + 5, 10, tracks, expired);
+    CHECK(expired.size() == 50);
+    for (std::uint32_t track_id : expired)
+    {
+        CHECK((track_id - 1) % 2 == 1);
+    }
+    CHECK(wheel.size() == 0);
+}
+
+// 随机时间线与逐条参照比对：每条航迹在第一次满足 last < now - timeout 的推进中到期，不早不晚
+TEST_CASE("时间轮：随机更新与推进与参照模型一致", "[TimerWheel]")
+{
+    const std::int64_t timeout = 300;
+    TimerWheel wheel(0, 1);
+    FakeTracks tracks;
+    std::mt19937_64 rng(12345);
+
+    std::uint32_t next_slot = 0;
+    std::int64_t now = 0;
+    std::vector<std::uint32_t> expired;
+    for (int round = 0; round < 4000; ++round)
+    {
+        // 新建
+        if (rng() % 4 == 0)
+        {
+            wheel.schedule(next_slot, next_slot + 1);
+            tracks.last_update[next_slot] = now;
+            next_slot++;
+        }
+        // 部分航迹写入
+        for (auto &entry : tracks.last_update)
+        {
+            if (rng() % 8 == 0)
+                entry.second = now;
+        }
+        // 推进：多数为小步，偶尔跨越第1、2层
+        std::uint64_t r = rng() % 100;
+        now += r < 90 ? std::int64_t(rng() % 200) : (r < 98 ? std::int64_t(rng() % (4 * LEVEL1_SPAN)) : std::int64_t(rng() % (2 * LEVEL2_SPAN)));
+
+        wheel.advance(now, timeout, tracks, expired);
+        std::set<std::uint32_t> got;
+        for (std::uint32_t track_id : expired)
+            got.insert(track_id - 1);
+        expired.clear();
+
+        std::set<std::uint32_t> want;
+        for (const auto &entry : tracks.last_update)
+        {
+            if (entry.second < now - timeout)
+                want.insert(entry.first);
+        }
+        REQUIRE(got == want);
+        for (std::uint32_t slot : got)
+            tracks.last_update.erase(slot);
+    }
+    CHECK(wheel.size() == tracks.last_update.size());
+}
@@ -0,0 +1,127 @@
+/*****************************************************************************
+ * @file TrackArena_TEST.cpp
+ * @brief 存储区测试：顺序切分对齐且互不重叠，非平凡类型就地构造，空间不足时返回空指针，归还物理页后地址仍可写入
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unistd.h>
+
+#include "TrackArena.hpp"
+
+using namespace track_project::trackmanager;
+
+namespace
+{
+    bool aligned(const void *ptr)
+    {
+        return reinterpret_cast<std::uintptr_t>(ptr) % TrackArena::ALIGNMENT == 0;
+    }
+}
+
+TEST_CASE("存储区：顺序切分按缓存行对齐、互不重叠，未写入的内存为零", "[TrackArena]")
+{
+    const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    TrackArena arena(3 * page_size);
+    CHECK(arena.size_bytes() == 3 * page_size);
+    CHECK(arena.used_bytes() == 0);
+    CHECK_FALSE(arena.huge_pages());
+
+    // 1.不同类型与长度交替切分，占用按对齐后的字节数累加
+    char *bytes = arena.carve<char>(1);
+    double *doubles = arena.carve<double>(10);
+    char *tail = arena.carve<char>(65);
+    REQUIRE(bytes != nullptr);
+    REQUIRE(doubles != nullptr);
+    REQUIRE(tail != nullptr);
+    CHECK(aligned(bytes));
+    CHECK(aligned(doubles));
+    CHECK(aligned(tail));
+    CHECK(reinterpret_cast<char *>(doubles) == bytes + TrackArena::bytes_for<char>(1));
+    CHECK(tail == reinterpret_cast<char *>(doubles) + TrackArena::bytes_for<double>(10));
+    CHECK(TrackArena::bytes_for<char>(65) == 2 * TrackArena::ALIGNMENT);
+    CHECK(arena.used_bytes() == TrackArena::bytes_for<char>(1) + TrackArena::bytes_for<double>(10) + TrackArena::bytes_for<char>(65));
+
+    // 2.平凡类型直接使用零页
+    for (int i = 0; i < 10; ++i)
+    {
+        CHECK(doubles[i] == 0.0);
+        doubles[i] = i;
+    }
+    CHECK(*bytes == 0);
+    CHECK(tail[64] == 0);
+
+    // 3.非平凡类型就地默认构造
+    std::string *strings = arena.carve<std::string>(3);
+    REQUIRE(strings != nullptr);
+    CHECK(aligned(strings));
+    for (int i = 0; i < 3; ++i)
+    {
+        CHECK(strings[i].empty());
+        strings[i] = "track";
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        strings[i].~basic_string();
+    }
+}
+
+TEST_CASE("存储区：剩余空间不足时返回空指针且不占用空间，恰好用尽时成功", "[TrackArena]")
+{
+    const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    TrackArena arena(page_size);
+    REQUIRE(arena.size_bytes() == page_size);
+
+    // 1.超过总大小与数量溢出
+    CHECK(arena.carve<char>(page_size + 1) == nullptr);
+    CHECK(arena.carve<double>(std::numeric_limits<size_t>::max() / 4) == nullptr);
+    CHECK(arena.used_bytes() == 0);
+
+    // 2.切到只剩一个对齐单位，再申请两个单位失败，一个单位成功
+    REQUIRE(arena.carve<char>(page_size - TrackArena::ALIGNMENT) != nullptr);
+    CHECK(arena.carve<char>(TrackArena::ALIGNMENT + 1) == nullptr);
+    CHECK(arena.used_bytes() == page_size - TrackArena::ALIGNMENT);
+    char *last = arena.carve<char>(TrackArena::ALIGNMENT);
+    REQUIRE(last != nullptr);
+    last[TrackArena::ALIGNMENT - 1] = 1; // 最后一个字节在映射区内
+
+    // 3.用尽后任何非零申请都失败
+    CHECK(arena.used_bytes() == arena.size_bytes());
+    CHECK(arena.carve<char>(1) == nullptr);
+    CHECK(arena.used_bytes() == arena.size_bytes());
+}
+
+TEST_CASE("存储区：discard只归还完整覆盖的页，归还后读到零且可再次写入", "[TrackArena]")
+{
+    const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    TrackArena arena(4 * page_size);
+    char *block = arena.carve<char>(4 * page_size);
+    REQUIRE(block != nullptr);
+    for (size_t i = 0; i < 4 * page_size; ++i)
+    {
+        block[i] = 7;
+    }
+
+    // 1.不足一页或未覆盖整页的区间不归还
+    CHECK(arena.discard(block + 1, page_size) == 0);
+    CHECK(block[1] == 7);
+
+    // 2.[1, 3页+1)只完整覆盖第2、3页
+    CHECK(arena.discard(block + 1, 3 * page_size) == 2 * page_size);
+    CHECK(block[page_size - 1] == 7);
+    CHECK(block[page_size] == 0);
+    CHECK(block[3 * page_size - 1] == 0);
+    CHECK(block[3 * page_size] == 7);
+
+    // 3.归还的页再次写入按零页重新分配
+    block[page_size] = 9;
+    CHECK(block[page_size] == 9);
+    CHECK(block[page_size + 1] == 0);
+}
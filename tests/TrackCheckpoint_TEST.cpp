@@ -0,0 +1,202 @@
+/*****************************************************************************
+ * @file TrackCheckpoint_TEST.cpp
+ * @brief 检查点测试：保存-恢复往返一致，损坏的检查点被拒绝且管理器保持原状
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+
+#include "TrackerManager.hpp"
+#include "TrackCheckpoint.hpp"
+
+using namespace track_project;
+using namespace track_project::trackmanager;
+
+namespace
+{
+    std::string temp_path(const char *name)
+    {
+        return "/tmp/trackmanager_" + std::to_string(::getpid()) + "_" + name;
+    }
+
+    std::vector<char> read_file(const std::string &path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void write_file(const std::string &path, const std::vector<char> &bytes)
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    // 检查点中uint32段的起始偏移：0为代数段，1为空闲列表段，2为活跃ID段
+    size_t section_offset(const std::vector<char> &bytes, int section)
+    {
+        CheckpointHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        size_t offset = checkpoint_align(sizeof(CheckpointHeader));
+        if (section > 0)
+            offset += checkpoint_align(header.capacity * sizeof(std::uint32_t));
+        if (section > 1)
+            offset += checkpoint_align(header.free_count * sizeof(std::uint32_t));
+        return offset;
+    }
+
+    std::uint32_t read_u32(const std::vector<char> &bytes, size_t offset)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, bytes.data() + offset, sizeof(value));
+        return value;
+    }
+
+    void write_u32(std::vector<char> &bytes, size_t offset, std::uint32_t value)
+    {
+        std::memcpy(bytes.data() + offset, &value, sizeof(value));
+    }
+
+    // 两个管理器的航迹ID、航迹头、点迹逐一相同
+    void require_same_tracks(const TrackerManager &expected, const TrackerManager &actual)
+    {
+        REQUIRE(actual.get_active_track_ids() == expected.get_active_track_ids());
+        for (std::uint32_t track_id : expected.get_active_track_ids())
+        {
+            const TrackerHeader *a = expected.get_header_ref(track_id);
+            const TrackerHeader *b = actual.get_header_ref(track_id);
+            REQUIRE(b != nullptr);
+            CHECK(b->track_id == a->track_id);
+            CHECK(b->state == a->state);
+            CHECK(b->point_num == a->point_num);
+            CHECK(b->extrapolation_count == a->extrapolation_count);
+
+            const LatestKBuffer<TrackPoint> *x = expected.get_data_ref(track_id);
+            const LatestKBuffer<TrackPoint> *y = actual.get_data_ref(track_id);
+            REQUIRE(y->size() == x->size());
+            for (size_t i = 0; i < x->size(); ++i)
+            {
+                CHECK((*y)[i].longitude == (*x)[i].longitude);
+                CHECK((*y)[i].latitude == (*x)[i].latitude);
+                CHECK((*y)[i].time.milliseconds == (*x)[i].time.milliseconds);
+            }
+        }
+    }
+
+    // 有删除、复用、环形缓冲区回绕与存储搬迁的管理器
+    void populate(TrackerManager &manager)
+    {
+        std::vector<std::uint32_t> ids;
+        for (int i = 0; i < 40; ++i)
+        {
+            ids.push_back(manager.create_track());
+        }
+        for (int i = 0; i < 40; ++i)
+        {
+            // 航迹长度64，部分航迹写满后回绕
+            const int count = (i * 7) % 150;
+            for (int k = 0; k < count; ++k)
+            {
+                manager.push_track_point(ids[i], test::make_point(120.0 + i * 0.01, 30.0 + k * 0.001, 1000 + k));
+            }
+        }
+        for (int i = 0; i < 40; i += 3)
+        {
+            manager.delete_track(ids[i]);
+        }
+        for (int i = 0; i < 5; ++i)
+        {
+            manager.push_track_point(manager.create_track(), test::make_point(121.0, 31.0 + i, 5000));
+        }
+    }
+}
+
+TEST_CASE("检查点：保存后恢复，航迹ID、下一个ID与点迹完全一致", "[TrackCheckpoint]")
+{
+    const std::string path = temp_path("roundtrip.ckpt");
+    TrackerManager original(64, 64, false, 512);
+    populate(original);
+    REQUIRE(original.save_checkpoint(path));
+
+    TrackerManager restored(64, 64, false, 512);
+    restored.create_track();
+    REQUIRE(restored.load_checkpoint(path));
+
+    require_same_tracks(original, restored);
+    CHECK(restored.get_next_track_id() == original.get_next_track_id());
+    CHECK(restored.get_used_count() == original.get_used_count());
+
+    // 此后的分配顺序也一致
+    for (int i = 0; i < 30; ++i)
+    {
+        REQUIRE(restored.create_track() == original.create_track());
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("检查点：损坏的空闲列表、代数与ID被拒绝，管理器保持原状", "[TrackCheckpoint]")
+{
+    const std::string path = temp_path("valid.ckpt");
+    const std::string corrupt_path = temp_path("corrupt.ckpt");
+    TrackerManager source(64, 64, false, 512);
+    populate(source);
+    REQUIRE(source.save_checkpoint(path));
+    const std::vector<char> valid = read_file(path);
+
+    CheckpointHeader header;
+    std::memcpy(&header, valid.data(), sizeof(header));
+    REQUIRE(header.free_count >= 2);
+    REQUIRE(header.active_count >= 1);
+    const size_t generations = section_offset(valid, 0);
+    const size_t free_list = section_offset(valid, 1);
+    const size_t active_ids = section_offset(valid, 2);
+    const std::uint32_t first_active_slot = (read_u32(valid, active_ids) & ((1u << header.index_bits) - 1)) - 1;
+
+    std::vector<char> bytes = valid;
+    SECTION("空闲列表重复")
+    {
+        write_u32(bytes, free_list + 4, read_u32(bytes, free_list));
+    }
+    SECTION("空闲槽位同时是活跃航迹")
+    {
+        write_u32(bytes, free_list, first_active_slot);
+    }
+    SECTION("代数超过上限")
+    {
+        write_u32(bytes, generations + 4 * read_u32(bytes, free_list), source.get_max_generation() + 1);
+    }
+    SECTION("空闲槽位已退役")
+    {
+        write_u32(bytes, generations + 4 * read_u32(bytes, free_list), source.get_max_generation());
+    }
+    SECTION("活跃ID与槽位代数不符")
+    {
+        write_u32(bytes, generations + 4 * first_active_slot, read_u32(bytes, generations + 4 * first_active_slot) + 1);
+    }
+    write_file(corrupt_path, bytes);
+
+    TrackerManager target(64, 64, false, 512);
+    std::vector<std::uint32_t> existing;
+    for (int i = 0; i < 3; ++i)
+    {
+        existing.push_back(target.create_track());
+    }
+    CHECK_FALSE(target.load_checkpoint(corrupt_path));
+    CHECK(target.get_active_track_ids() == existing);
+
+    // 未损坏的文件仍可恢复
+    REQUIRE(target.load_checkpoint(path));
+    require_same_tracks(source, target);
+
+    std::remove(path.c_str());
+    std::remove(corrupt_path.c_str());
+}
@@ -0,0 +1,222 @@
+/*****************************************************************************
+ * @file TrackGate_TEST.cpp
+ * @brief 波门筛选测试：网格粗筛加精筛的结果与逐对暴力计算一致，经管理服务按快照筛选结果相同
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+
+#include "TrackerManager.hpp"
+#include "TrackGate.hpp"
+#include "SpatialGrid.hpp"
+#include "ManagementService.hpp"
+
+using namespace track_project;
+using namespace track_project::trackmanager;
+
+namespace
+{
+    constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+    constexpr double M = SpatialGrid::METERS_PER_DEGREE;
+
+    using Candidates = std::vector<std::vector<std::uint32_t>>;
+
+    struct Track
+    {
+        std::uint32_t track_id;
+        TrackPoint latest;
+    };
+
+    // 逐对计算：航迹最新点迹按航速航向外推到点迹时刻，在点迹处的局部等距投影下距离不超过波门半径
+    Candidates brute_force(const std::vector<Track> &tracks, const std::vector<TrackPoint> &plots, double radius_m)
+    {
+        Candidates result(plots.size());
+        for (size_t p = 0; p < plots.size(); ++p)
+        {
+            const TrackPoint &plot = plots[p];
+            const double plot_meters_per_lon = M * std::max(std::cos(plot.latitude * DEG_TO_RAD), 1e-6);
+            for (const Track &track : tracks)
+            {
+                const TrackPoint &t = track.latest;
+                const double meters_per_lon = M * std::max(std::cos(t.latitude * DEG_TO_RAD), 1e-6);
+                const double dt = static_cast<double>(plot.time.milliseconds - t.time.milliseconds) / 1000.0;
+                const double longitude = t.longitude + t.sog * std::sin(t.cog * DEG_TO_RAD) / meters_per_lon * dt;
+                const double latitude = t.latitude + t.sog * std::cos(t.cog * DEG_TO_RAD) / M * dt;
+                const double dx = (longitude - plot.longitude) * plot_meters_per_lon;
+                const double dy = (latitude - plot.latitude) * M;
+                if (dx * dx + dy * dy <= radius_m * radius_m)
+                    result[p].push_back(track.track_id);
+            }
+            std::sort(result[p].begin(), result[p].end());
+        }
+        return result;
+    }
+
+    void sort_all(Candidates &candidates)
+    {
+        for (auto &list : candidates)
+            std::sort(list.begin(), list.end());
+    }
+
+    // 航迹高速、任意航向；点迹落在航迹外推位置附近，时间跨度大
+    void make_scenario(std::mt19937 &rng, double base_latitude, size_t track_count, size_t plot_count,
+                       std::vector<TrackPoint> &latest, std::vector<TrackPoint> &plots)
+    {
+        std::uniform_real_distribution<double> lon(120.0, 120.5);
+        std::uniform_real_distribution<double> lat(base_latitude, base_latitude + 0.5);
+        std::uniform_real_distribution<double> speed(0.0, 300.0);
+        std::uniform_real_distribution<double> course(0.0, 360.0);
+        std::uniform_int_distribution<std::int64_t> track_time(100000, 160000);
+        std::uniform_int_distribution<std::int64_t> plot_time(100000, 220000);
+        std::uniform_real_distribution<double> offset(0.0, 3000.0);
+        std::uniform_int_distribution<size_t> pick(0, track_count - 1);
+
+        latest.clear();
+        for (size_t i = 0; i < track_count; ++i)
+        {
+            TrackPoint point = test::make_point(lon(rng), lat(rng), track_time(rng));
+            point.sog = speed(rng);
+            point.cog = course(rng);
+            latest.push_back(point);
+        }
+
+        plots.clear();
+        for (size_t i = 0; i < plot_count; ++i)
+        {
+            const TrackPoint &t = latest[pick(rng)];
+            const std::int64_t time_ms = plot_time(rng);
+            const double dt = static_cast<double>(time_ms - t.time.milliseconds) / 1000.0;
+            const double longitude = t.longitude + t.sog * std::sin(t.cog * DEG_TO_RAD) * dt / (M * std::cos(t.latitude * DEG_TO_RAD));
+            const double latitude = t.latitude + t.sog * std::cos(t.cog * DEG_TO_RAD) * dt / M;
+            // 偏离外推位置0~3km，大量点迹落在波门边界附近
+            const double distance = offset(rng), bearing = course(rng) * DEG_TO_RAD;
+            plots.push_back(test::make_point(longitude + distance * std::sin(bearing) / (M * std::cos(latitude * DEG_TO_RAD)),
+                                             latitude + distance * std::cos(bearing) / M, time_ms));
+        }
+    }
+
+    template <typename Predicate>
+    bool wait_until(Predicate &&predicate, int timeout_ms = 5000)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (!predicate())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+}
+
+TEST_CASE("波门筛选：网格筛选结果与逐对暴力计算一致", "[TrackGate]")
+{
+    std::mt19937 rng(20251215);
+    TrackGate gate(4, 0.01);
+
+    // 高纬度航迹外推时经度投影系数变化大，粗筛半径须严格覆盖
+    for (double base_latitude : {0.0, 30.0, 60.0, 80.0})
+    {
+        for (double radius_m : {200.0, 2000.0})
+        {
+            std::vector<TrackPoint> latest, plots;
+            make_scenario(rng, base_latitude, 300, 2000, latest, plots);
+
+            TrackerManager manager(512, 8, false, 512);
+            std::vector<Track> tracks;
+            for (const TrackPoint &point : latest)
+            {
+                std::uint32_t track_id = manager.create_track();
+                REQUIRE(track_id != 0);
+                manager.push_track_point(track_id, point);
+                tracks.push_back({track_id, point});
+            }
+
+            Candidates candidates;
+            gate.gate(manager, plots, radius_m, candidates);
+            sort_all(candidates);
+            const Candidates expected = brute_force(tracks, plots, radius_m);
+
+            size_t hits = 0;
+            for (size_t p = 0; p < plots.size(); ++p)
+            {
+                INFO("纬度 " << base_latitude << " 波门 " << radius_m << " 点迹 " << p);
+                REQUIRE(candidates[p] == expected[p]);
+                hits += expected[p].size();
+            }
+            CHECK(gate.track_count() == tracks.size());
+            CHECK(hits > 0);
+        }
+    }
+}
+
+// 粗筛最不利的情形：高纬度斜向高速航迹，点迹时刻远离参考时刻，点迹在波门边界内侧且背离参考时刻的预测位置
+TEST_CASE("波门筛选：高纬度斜向航迹在波门边界的点迹不被粗筛漏掉", "[TrackGate]")
+{
+    TrackerManager manager(64, 8, false, 64);
+    TrackPoint latest = test::make_point(120.0, 80.0, 100000);
+    latest.sog = 300.0;
+    latest.cog = 135.0;
+    const std::uint32_t track_id = manager.create_track();
+    manager.push_track_point(track_id, latest);
+
+    // 两个点迹时刻相差240秒，参考时刻为中点
+    const double radius_m = 2000.0;
+    const double meters_per_lon = M * std::cos(80.0 * DEG_TO_RAD);
+    const double lon_rate = 300.0 * std::sin(135.0 * DEG_TO_RAD) / meters_per_lon;
+    const double lat_rate = 300.0 * std::cos(135.0 * DEG_TO_RAD) / M;
+    const double lon_plot = 120.0 + lon_rate * 240.0, lat_plot = 80.0 + lat_rate * 240.0;
+    const double lon_ref = 120.0 + lon_rate * 120.0, lat_ref = 80.0 + lat_rate * 120.0;
+
+    // 沿参考位置指向点迹时刻预测位置的方向，在点迹处投影下偏移0.999倍波门半径
+    const double plot_meters_per_lon = M * std::cos(lat_plot * DEG_TO_RAD);
+    const double ex = (lon_plot - lon_ref) * plot_meters_per_lon, ey = (lat_plot - lat_ref) * M;
+    const double norm = std::hypot(ex, ey);
+    std::vector<TrackPoint> plots{test::make_point(120.0, 80.0, 100000),
+                                  test::make_point(lon_plot + 0.999 * radius_m * ex / norm / plot_meters_per_lon,
+                                                   lat_plot + 0.999 * radius_m * ey / norm / M, 340000)};
+
+    TrackGate gate(1, 0.01);
+    Candidates candidates;
+    gate.gate(manager, plots, radius_m, candidates);
+    const Candidates expected = brute_force({{track_id, latest}}, plots, radius_m);
+    REQUIRE(expected[1] == std::vector<std::uint32_t>{track_id});
+    CHECK(candidates == expected);
+}
+
+TEST_CASE("波门筛选：管理服务按快照筛选，与直接筛选航迹管理器结果一致", "[TrackGate]")
+{
+    std::mt19937 rng(7);
+    std::vector<TrackPoint> latest, plots;
+    make_scenario(rng, 30.0, 100, 500, latest, plots);
+
+    ManagementService service(128, 8, 256, 600000, "", 0);
+    std::vector<std::array<TrackPoint, 4>> tracks;
+    for (const TrackPoint &point : latest)
+        tracks.push_back({point, point, point, point});
+    service.create_track_command(std::move(tracks));
+    REQUIRE(wait_until([&]
+                       { return service.acquire_snapshot()->size() == latest.size(); }));
+
+    TrackGate gate(2, 0.01);
+    Candidates from_snapshot, from_manager;
+    service.gate_plots(gate, plots, 2000.0, from_snapshot);
+
+    service.pause_processing(); // 暂停期间航迹管理器不被修改，可直接读取
+    gate.gate(service.get_tracker_manager(), plots, 2000.0, from_manager);
+    service.resume_processing();
+
+    sort_all(from_snapshot);
+    sort_all(from_manager);
+    CHECK(from_snapshot == from_manager);
+    CHECK(gate.track_count() == latest.size());
+}
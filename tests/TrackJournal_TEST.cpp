@@ -0,0 +1,77 @@
+/*****************************************************************************
+ * @file TrackJournal_TEST.cpp
+ * @brief 变更日志测试：增量拉取、删除记录溢出后退化为整体失效
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include "TrackerManager.hpp"
+
+using namespace track_project;
+using namespace track_project::trackmanager;
+using track_project::test::to_set;
+
+TEST_CASE("变更日志：增量拉取新建、更新与删除", "[TrackJournal]")
+{
+    TrackerManager manager(100, 64, false, 1000);
+    std::uint32_t a = manager.create_track();
+    std::uint32_t b = manager.create_track();
+
+    int consumer = manager.register_change_consumer();
+    REQUIRE(consumer >= 0);
+    TrackChanges changes;
+    manager.poll_changes(consumer, changes);
+    CHECK(changes.cleared);
+    CHECK(to_set(changes.updated_ids) == std::set<std::uint32_t>{a, b});
+
+    manager.push_track_point(a, test::make_point(120.0, 30.0));
+    manager.delete_track(b);
+    manager.poll_changes(consumer, changes);
+    CHECK_FALSE(changes.cleared);
+    CHECK(changes.updated_ids == std::vector<std::uint32_t>{a});
+    CHECK(changes.deleted_ids == std::vector<std::uint32_t>{b});
+
+    manager.poll_changes(consumer, changes);
+    CHECK(changes.empty());
+}
+
+// 消费者长期不拉取：删除记录不超过槽位总数，溢出后下一次拉取为整体失效加全部现存航迹
+TEST_CASE("变更日志：删除记录溢出后退化为整体失效", "[TrackJournal]")
+{
+    TrackerManager manager(64, 16, false, 64);
+    int idle = manager.register_change_consumer();
+    int active = manager.register_change_consumer();
+    TrackChanges changes;
+    manager.poll_changes(idle, changes);
+    manager.poll_changes(active, changes);
+
+    // 反复创建删除，远超槽位总数；按时拉取的消费者不受影响
+    std::uint32_t survivor = manager.create_track();
+    for (int i = 0; i < 10000; ++i)
+    {
+        std::uint32_t id = manager.create_track();
+        REQUIRE(id != 0);
+        manager.delete_track(id);
+        if (i % 10 == 0)
+        {
+            manager.poll_changes(active, changes);
+            REQUIRE_FALSE(changes.cleared);
+        }
+    }
+    std::uint32_t late = manager.create_track();
+
+    manager.poll_changes(idle, changes);
+    CHECK(changes.cleared);
+    CHECK(changes.deleted_ids.size() <= manager.get_total_capacity());
+    CHECK(to_set(changes.updated_ids) == std::set<std::uint32_t>{survivor, late});
+
+    // 退化后恢复为普通增量
+    manager.delete_track(late);
+    manager.poll_changes(idle, changes);
+    CHECK_FALSE(changes.cleared);
+    CHECK(changes.deleted_ids == std::vector<std::uint32_t>{late});
+}
@@ -0,0 +1,195 @@
+/*****************************************************************************
+ * @file TrackPointPool_TEST.cpp
+ * @brief 分级点迹存储池测试：级别划分、块复用与用尽时返回空指针；
+ *        航迹按32 -> 128 -> 512逐级搬迁，搬迁前后点迹内容与顺序不变
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <set>
+
+#include "TrackPointPool.hpp"
+#include "TrackerManager.hpp"
+
+using namespace track_project;
+using namespace track_project::trackmanager;
+
+namespace
+{
+    // 点迹经度为写入序号
+    TrackPoint numbered(std::uint32_t sequence)
+    {
+        return test::make_point(static_cast<double>(sequence), 30.0, 1000 + sequence);
+    }
+
+    // 航迹内容为最后points.size()个写入序号，顺序从旧到新
+    void require_sequence(const TrackerManager &manager, std::uint32_t track_id, std::uint32_t written, size_t expected_size)
+    {
+        auto session = manager.read_session();
+        TrackerHeader header;
+        std::vector<TrackPoint> points;
+        REQUIRE(session.read_track(track_id, header, points));
+        REQUIRE(points.size() == expected_size);
+        REQUIRE(header.point_num == expected_size);
+        const std::uint32_t first = written - static_cast<std::uint32_t>(expected_size);
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            REQUIRE(points[i].longitude == static_cast<double>(first + i));
+            REQUIRE(points[i].time.milliseconds == 1000 + first + static_cast<std::int64_t>(i));
+        }
+    }
+
+    size_t block_bytes(std::uint32_t length)
+    {
+        return TrackArena::bytes_for<TrackPoint>(length);
+    }
+}
+
+TEST_CASE("分级存储池：级别按4倍增长到长度上限，块释放后复用，用尽时返回空指针", "[TrackPointPool]")
+{
+    // 1.级别表：32、128、512、2000
+    TrackPointPool pool(3, 2000);
+    REQUIRE(pool.class_count() == 4);
+    CHECK(pool.class_length(0) == 32);
+    CHECK(pool.class_length(1) == 128);
+    CHECK(pool.class_length(2) == 512);
+    CHECK(pool.class_length(3) == 2000);
+    CHECK_FALSE(pool.is_top_class(2));
+    CHECK(pool.is_top_class(3));
+
+    // 长度上限小于最小级别时只有一级
+    TrackPointPool tiny(1, 8);
+    CHECK(tiny.class_count() == 1);
+    CHECK(tiny.class_length(0) == 8);
+
+    // 2.每级最多block_count个块，块互不相同
+    std::set<TrackPoint *> blocks;
+    for (int i = 0; i < 3; ++i)
+    {
+        TrackPoint *block = pool.acquire(0);
+        REQUIRE(block != nullptr);
+        blocks.insert(block);
+        block[31] = numbered(i); // 整块可写
+    }
+    CHECK(blocks.size() == 3);
+    CHECK(pool.in_use(0) == 3);
+    CHECK(pool.acquire(0) == nullptr);
+    CHECK(pool.in_use(0) == 3);
+    CHECK(pool.used_bytes() == 3 * block_bytes(32));
+
+    // 3.其他级别不受影响
+    TrackPoint *large = pool.acquire(3);
+    REQUIRE(large != nullptr);
+    large[1999] = numbered(1999);
+    CHECK(pool.used_bytes() == 3 * block_bytes(32) + block_bytes(2000));
+
+    // 4.释放后后进先出复用，复用不超过上限
+    TrackPoint *released = *blocks.begin();
+    pool.release(released, 0);
+    CHECK(pool.in_use(0) == 2);
+    CHECK(pool.acquire(0) == released);
+    CHECK(pool.acquire(0) == nullptr);
+    pool.release(nullptr, 0); // 空指针忽略
+    CHECK(pool.in_use(0) == 3);
+
+    // 5.trim后空闲块仍可复用
+    pool.release(large, 3);
+    CHECK(pool.trim() > 0);
+    CHECK(pool.acquire(3) == large);
+}
+
+TEST_CASE("分级存储池：航迹写满后逐级搬迁到32 -> 128 -> 512 -> 2000，点迹内容与顺序不变", "[TrackPointPool]")
+{
+    TrackerManager manager(4, 2000, false, 4);
+    const std::uint32_t track_id = manager.create_track();
+    REQUIRE(track_id != 0);
+    CHECK(manager.get_point_storage_bytes() == block_bytes(32));
+
+    // 每个级别写满时与搬迁后各检查一次：搬迁发生在写入下一个点迹时
+    std::uint32_t written = 0;
+    auto push_to = [&](std::uint32_t count)
+    {
+        for (; written < count; ++written)
+        {
+            REQUIRE(manager.push_track_point(track_id, numbered(written)));
+        }
+    };
+    const std::vector<std::pair<std::uint32_t, std::uint32_t>> stages{{32, 128}, {128, 512}, {512, 2000}};
+    for (const auto &[length, next_length] : stages)
+    {
+        INFO("级别 " << length << " -> " << next_length);
+        push_to(length);
+        CHECK(manager.get_point_storage_bytes() == block_bytes(length));
+        require_sequence(manager, track_id, written, length);
+
+        push_to(length + 1);
+        CHECK(manager.get_point_storage_bytes() == block_bytes(next_length));
+        require_sequence(manager, track_id, written, length + 1);
+    }
+
+    // 最高一级写满后滚动覆盖最旧点迹，不再搬迁
+    push_to(2000 + 37);
+    CHECK(manager.get_point_storage_bytes() == block_bytes(2000));
+    require_sequence(manager, track_id, written, 2000);
+
+    // 删除后全部级别的块归还
+    REQUIRE(manager.delete_track(track_id));
+    CHECK(manager.get_point_storage_bytes() == 0);
+}
+
+TEST_CASE("分级存储池：多条航迹交替搬迁后彼此的点迹不串扰，释放的块被后续航迹复用", "[TrackPointPool]")
+{
+    TrackerManager manager(8, 512, false, 8);
+    std::vector<std::uint32_t> ids;
+    for (int i = 0; i < 4; ++i)
+    {
+        ids.push_back(manager.create_track());
+        REQUIRE(ids.back() != 0);
+    }
+
+    // 每条航迹写入不同数量，交替写入使各级块交错分配；点迹纬度为航迹序号
+    const std::vector<std::uint32_t> counts{20, 100, 300, 600};
+    for (std::uint32_t step = 0; step < 600; ++step)
+    {
+        for (size_t t = 0; t < ids.size(); ++t)
+        {
+            if (step < counts[t])
+            {
+                TrackPoint point = numbered(step);
+                point.latitude = static_cast<double>(t);
+                REQUIRE(manager.push_track_point(ids[t], point));
+            }
+        }
+    }
+    for (size_t t = 0; t < ids.size(); ++t)
+    {
+        auto session = manager.read_session();
+        TrackerHeader header;
+        std::vector<TrackPoint> points;
+        REQUIRE(session.read_track(ids[t], header, points));
+        const std::uint32_t kept = std::min<std::uint32_t>(counts[t], 512);
+        REQUIRE(points.size() == kept);
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            INFO("航迹 " << t << " 点迹 " << i);
+            REQUIRE(points[i].latitude == static_cast<double>(t));
+            REQUIRE(points[i].longitude == static_cast<double>(counts[t] - kept + i));
+        }
+    }
+    CHECK(manager.get_point_storage_bytes() == block_bytes(32) + block_bytes(128) + 2 * block_bytes(512));
+
+    // 删除大航迹后新航迹从最小级别开始，仍能逐级搬迁到512
+    REQUIRE(manager.delete_track(ids[3]));
+    const std::uint32_t reused = manager.create_track();
+    REQUIRE(reused != 0);
+    for (std::uint32_t i = 0; i < 513; ++i)
+    {
+        REQUIRE(manager.push_track_point(reused, numbered(i)));
+    }
+    require_sequence(manager, reused, 513, 512);
+    CHECK(manager.get_point_storage_bytes() == block_bytes(32) + block_bytes(128) + 2 * block_bytes(512));
+}
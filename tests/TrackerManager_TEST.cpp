@@ -0,0 +1,221 @@
+/*****************************************************************************
+ * @file TrackerManager_TEST.cpp
+ * @brief 航迹管理器测试：槽位生命周期与容量
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <unistd.h>
+
+#include "TrackerManager.hpp"
+#include "TrackCheckpoint.hpp"
+
+using namespace track_project;
+using namespace track_project::trackmanager;
+
+// 空闲槽位先进先出：反复创建删除时所有空闲槽位轮流使用，代数均匀增长，不会个别槽位提前退役
+TEST_CASE("槽位复用：反复创建删除时代数均匀增长，达到代数上限的槽位退役", "[TrackerManager]")
+{
+    // 容量上限64时槽位号+1占7位，其余为代数
+    TrackerManager manager(64, 16, false, 64);
+    const std::uint32_t max_generation = manager.get_max_generation();
+    REQUIRE(max_generation == (UINT32_MAX >> 7));
+    auto generation_of = [](std::uint32_t track_id)
+    { return track_id >> 7; };
+
+    std::vector<std::uint32_t> long_lived;
+    for (int i = 0; i < 16; ++i)
+    {
+        long_lived.push_back(manager.create_track());
+    }
+    const std::uint32_t churn_slots = 64 - 16;
+
+    // 1.每个空闲槽位恰好被复用相同次数
+    constexpr std::uint32_t ROUNDS = 20;
+    for (std::uint32_t cycle = 0; cycle < churn_slots * ROUNDS; ++cycle)
+    {
+        std::uint32_t id = manager.create_track();
+        REQUIRE(id != 0);
+        REQUIRE(manager.delete_track(id));
+    }
+    std::vector<std::uint32_t> filled;
+    for (std::uint32_t i = 0; i < churn_slots; ++i)
+    {
+        filled.push_back(manager.create_track());
+        REQUIRE(filled.back() != 0);
+        CHECK(generation_of(filled.back()) == ROUNDS);
+    }
+    CHECK(manager.get_used_count() == 64);
+    CHECK(manager.create_track() == 0);
+    for (std::uint32_t id : filled)
+    {
+        REQUIRE(manager.delete_track(id));
+    }
+
+    // 2.经检查点把空闲槽位的代数推到上限前一代，各复用一次后恰好达到上限并退役，此后创建失败而不是复用旧ID
+    const std::string path = "/tmp/trackmanager_" + std::to_string(::getpid()) + "_generations.ckpt";
+    REQUIRE(manager.save_checkpoint(path));
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        CheckpointHeader header;
+        file.read(reinterpret_cast<char *>(&header), sizeof(header));
+        std::vector<std::uint32_t> generations(header.capacity);
+        file.seekg(checkpoint_align(sizeof(CheckpointHeader)));
+        file.read(reinterpret_cast<char *>(generations.data()), generations.size() * sizeof(std::uint32_t));
+        for (std::uint32_t &generation : generations)
+        {
+            generation = generation == 0 ? 0 : max_generation - 1; // 长期存活的航迹代数为0，不修改
+        }
+        file.seekp(checkpoint_align(sizeof(CheckpointHeader)));
+        file.write(reinterpret_cast<const char *>(generations.data()), generations.size() * sizeof(std::uint32_t));
+    }
+    REQUIRE(manager.load_checkpoint(path));
+    std::remove(path.c_str());
+
+    for (std::uint32_t i = 0; i < churn_slots; ++i)
+    {
+        std::uint32_t id = manager.create_track();
+        REQUIRE(id != 0);
+        CHECK(generation_of(id) == max_generation - 1);
+        REQUIRE(manager.delete_track(id));
+    }
+    CHECK(manager.create_track() == 0);
+    CHECK(manager.get_used_count() == 16);
+    for (std::uint32_t id : long_lived)
+    {
+        CHECK(manager.is_valid_track(id));
+    }
+
+    // 3.长期存活的航迹删除后其槽位仍可复用
+    REQUIRE(manager.delete_track(long_lived.front()));
+    CHECK(manager.create_track() != 0);
+}
+
+// 老化按写入时的系统时钟判定，点迹自带的时间戳可以是任意基准
+TEST_CASE("静默老化：最后更新时刻取写入时的系统时钟而不是点迹时间", "[TrackerManager]")
+{
+    TrackerManager manager(64, 16, false, 64);
+    const std::int64_t timeout = 60000;
+
+    // 点迹时间远在未来与远在过去，均不影响老化
+    std::uint32_t future = manager.create_track();
+    std::uint32_t past = manager.create_track();
+    manager.push_track_point(future, test::make_point(120.0, 30.0, Timestamp::now().milliseconds + 100LL * 365 * 86400 * 1000));
+    manager.push_track_point(past, test::make_point(120.0, 30.0, 1));
+
+    std::vector<std::uint32_t> expired;
+    const std::int64_t now = Timestamp::now().milliseconds;
+    CHECK(manager.expire_silent_tracks(now + timeout / 2, timeout, expired) == 0);
+    CHECK(manager.get_used_count() == 2);
+
+    CHECK(manager.expire_silent_tracks(now + 2 * timeout, timeout, expired) == 2);
+    CHECK(test::to_set(expired) == std::set<std::uint32_t>{future, past});
+    CHECK(manager.get_used_count() == 0);
+}
+
+TEST_CASE("静默老化：关闭后不删除航迹、时间轮不随创建删除增长，重新开启后按开启时刻计时", "[TrackerManager]")
+{
+    TrackerManager manager(64, 16, false, 64);
+    const std::int64_t timeout = 60000;
+    std::vector<std::uint32_t> expired;
+    CHECK(manager.is_aging_enabled());
+
+    // 1.关闭老化：反复创建删除不留下时间轮条目，任意时刻都不删除
+    std::uint32_t kept = manager.create_track();
+    REQUIRE(manager.get_aging_entry_count() == 1);
+    manager.set_aging_enabled(false);
+    CHECK_FALSE(manager.is_aging_enabled());
+    CHECK(manager.get_aging_entry_count() == 0);
+    for (int i = 0; i < 1000; ++i)
+    {
+        REQUIRE(manager.delete_track(manager.create_track()));
+    }
+    CHECK(manager.get_aging_entry_count() == 0);
+    CHECK(manager.expire_silent_tracks(Timestamp::now().milliseconds + 100 * timeout, timeout, expired) == 0);
+    CHECK(expired.empty());
+    CHECK(manager.is_valid_track(kept));
+
+    // 2.重新开启：现存航迹挂入，按开启时刻计算静默时长
+    manager.set_aging_enabled(true);
+    CHECK(manager.get_aging_entry_count() == 1);
+    const std::int64_t now = Timestamp::now().milliseconds;
+    CHECK(manager.expire_silent_tracks(now + timeout / 2, timeout, expired) == 0);
+    CHECK(manager.expire_silent_tracks(now + 2 * timeout, timeout, expired) == 1);
+    CHECK(expired == std::vector<std::uint32_t>{kept});
+}
+
+// 批量写入与逐条写入对同一序列的结果完全一致，包括不存在、已删除与批次中途终结的航迹
+TEST_CASE("批量写入：结果与逐条调用push_track_point一致", "[TrackerManager]")
+{
+    TrackerManager per_point(64, 64, false, 64), batched(64, 64, false, 64);
+    std::vector<std::uint32_t> ids;
+    for (int i = 0; i < 40; ++i)
+    {
+        ids.push_back(per_point.create_track());
+        REQUIRE(batched.create_track() == ids.back());
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        REQUIRE(per_point.delete_track(ids[i]));
+        REQUIRE(batched.delete_track(ids[i]));
+    }
+    ids.push_back(0);          // 非法ID
+    ids.push_back(0x7fffff00); // 从未分配的ID
+
+    // 未关联点迹约占一半，连续外推的航迹会在批次中途终结，此后的点迹被拒绝
+    std::mt19937 rng(8);
+    std::vector<std::pair<TrackerHeader, TrackPoint>> batch(3000);
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        batch[i].first.track_id = ids[rng() % ids.size()];
+        batch[i].second = test::make_point(120.0 + i * 1e-4, 30.0, 1000 + static_cast<std::int64_t>(i));
+        batch[i].second.is_associated = rng() % 2;
+    }
+    // 相邻重复ID走沿用解析结果的分支
+    batch[101].first.track_id = batch[100].first.track_id;
+
+    size_t expected_applied = 0;
+    std::vector<std::uint32_t> expected_terminated;
+    for (const auto &item : batch)
+    {
+        if (per_point.push_track_point(item.first.track_id, item.second))
+            expected_applied++;
+        else
+            expected_terminated.push_back(item.first.track_id);
+    }
+    std::sort(expected_terminated.begin(), expected_terminated.end());
+    expected_terminated.erase(std::unique(expected_terminated.begin(), expected_terminated.end()), expected_terminated.end());
+
+    std::vector<std::uint32_t> terminated;
+    CHECK(batched.push_track_points(batch, terminated) == expected_applied);
+    CHECK(terminated == expected_terminated);
+    REQUIRE(test::to_set(batched.get_active_track_ids()) == test::to_set(per_point.get_active_track_ids()));
+    CHECK(per_point.get_used_count() < 35); // 确有航迹在批次中终结
+
+    for (std::uint32_t track_id : per_point.get_active_track_ids())
+    {
+        const TrackerHeader *expected = per_point.get_header_ref(track_id);
+        const TrackerHeader *actual = batched.get_header_ref(track_id);
+        REQUIRE(actual != nullptr);
+        CHECK(actual->state == expected->state);
+        CHECK(actual->extrapolation_count == expected->extrapolation_count);
+        CHECK(actual->point_num == expected->point_num);
+
+        const auto *expected_points = per_point.get_data_ref(track_id);
+        const auto *actual_points = batched.get_data_ref(track_id);
+        REQUIRE(actual_points->size() == expected_points->size());
+        for (size_t i = 0; i < expected_points->size(); ++i)
+        {
+            CHECK((*actual_points)[i].longitude == (*expected_points)[i].longitude);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/*****************************************************************************
+ * @file WakeEvent_TEST.cpp
+ * @brief 空闲休眠与唤醒测试：生产者与消费者按服务工作线程的登记-复查-休眠流程反复交替，不出现漏唤醒
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+
+#include "BoundedMpmcQueue.hpp"
+#include "WakeEvent.hpp"
+
+using namespace track_project;
+using namespace track_project::trackmanager;
+
+TEST_CASE("休眠唤醒：多个生产者与休眠的消费者反复交替，没有一次唤醒丢失", "[WakeEvent]")
+{
+    // 消费者每次休眠的超时远大于正常唤醒延迟，休眠到超时即视为漏唤醒
+    constexpr int WAIT_TIMEOUT_MS = 1000;
+    constexpr std::uint32_t PRODUCERS = 4, ROUNDS_PER_PRODUCER = 3000;
+
+    WakeEvent wake;
+    REQUIRE(wake.valid());
+    BoundedMpmcQueue<std::uint32_t> queue(8);
+    std::atomic<std::uint64_t> consumed{0};
+
+    // 消费者：与ManagementService工作线程相同，登记休眠后复查队列，仍为空才休眠
+    std::uint64_t sleeps = 0, timed_out = 0;
+    std::thread consumer([&]
+                         {
+                             const std::uint64_t total = std::uint64_t(PRODUCERS) * ROUNDS_PER_PRODUCER;
+                             std::uint32_t item;
+                             while (consumed.load(std::memory_order_relaxed) < total)
+                             {
+                                 if (queue.try_pop(item))
+                                 {
+                                     consumed.fetch_add(1, std::memory_order_release);
+                                     continue;
+                                 }
+                                 wake.prepare_wait();
+                                 if (queue.size_approx() > 0)
+                                 {
+                                     wake.cancel_wait();
+                                     continue;
+                                 }
+                                 auto start = std::chrono::steady_clock::now();
+                                 wake.wait_for(WAIT_TIMEOUT_MS);
+                                 sleeps++;
+                                 timed_out += std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(WAIT_TIMEOUT_MS);
+                             } });
+
+    // 生产者：每次提交后等消费者取走再提交下一个，迫使消费者在两次提交之间进入休眠流程
+    std::vector<std::thread> producers;
+    for (std::uint32_t p = 0; p < PRODUCERS; ++p)
+    {
+        producers.emplace_back([&, p]
+                               {
+                                   std::mt19937 rng(p);
+                                   for (std::uint32_t i = 0; i < ROUNDS_PER_PRODUCER; ++i)
+                                   {
+                                       const std::uint64_t before = consumed.load(std::memory_order_acquire);
+                                       while (!queue.try_push(p))
+                                           std::this_thread::yield();
+                                       wake.notify();
+                                       while (consumed.load(std::memory_order_acquire) == before)
+                                           std::this_thread::yield();
+                                       if (rng() % 4 == 0)
+                                           std::this_thread::sleep_for(std::chrono::microseconds(rng() % 50));
+                                   } });
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+    consumer.join();
+
+    INFO("消费者休眠" << sleeps << "次");
+    CHECK(timed_out == 0);
+    CHECK(sleeps > 0);
+}
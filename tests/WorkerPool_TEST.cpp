@@ -0,0 +1,120 @@
+/*****************************************************************************
+ * @file WorkerPool_TEST.cpp
+ * @brief 分叉-汇合线程池测试：全部任务恰好执行一次，常驻线程或调用线程上的任务抛出异常时汇合后重新抛出，线程池可继续使用
+ *
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *****************************************************************************/
+#include "TestCommon.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "WorkerPool.hpp"
+
+using namespace track_project::trackmanager;
+
+namespace
+{
+    // 每个任务各自计数，检查恰好执行一次
+    void require_all_once(WorkerPool &pool, std::uint32_t task_count)
+    {
+        std::vector<std::atomic<int>> runs(task_count);
+        pool.run(task_count, [&](std::uint32_t i)
+                 { runs[i].fetch_add(1, std::memory_order_relaxed); });
+        for (std::uint32_t i = 0; i < task_count; ++i)
+        {
+            REQUIRE(runs[i].load() == 1);
+        }
+    }
+}
+
+TEST_CASE("线程池：全部任务恰好执行一次，线程总数含调用线程", "[WorkerPool]")
+{
+    for (std::uint32_t thread_count : {0u, 1u, 4u})
+    {
+        WorkerPool pool(thread_count);
+        CHECK(pool.size() == std::max(thread_count, 1u));
+        for (std::uint32_t task_count : {0u, 1u, 3u, 1000u})
+        {
+            INFO("线程 " << thread_count << " 任务 " << task_count);
+            require_all_once(pool, task_count);
+        }
+    }
+}
+
+TEST_CASE("线程池：常驻线程上的任务抛出异常时汇合后在调用线程重新抛出，之后可继续使用", "[WorkerPool]")
+{
+    WorkerPool pool(4);
+    const std::thread::id caller = std::this_thread::get_id();
+
+    // 只在常驻线程上抛出：调用线程领到的第一个任务等到常驻线程抛出后才结束，保证常驻线程领到任务
+    std::atomic<bool> thrown{false};
+    std::atomic<int> finished{0};
+    CHECK_THROWS_AS(pool.run(1000, [&](std::uint32_t)
+                             {
+                                 if (std::this_thread::get_id() != caller)
+                                 {
+                                     if (!thrown.exchange(true))
+                                         throw std::runtime_error("worker");
+                                 }
+                                 else
+                                 {
+                                     const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+                                     while (!thrown.load() && std::chrono::steady_clock::now() < deadline)
+                                         std::this_thread::yield();
+                                 }
+                                 finished.fetch_add(1); }),
+                    std::runtime_error);
+    CHECK(thrown.load());
+    CHECK(finished.load() < 1000);
+
+    // run返回时没有任务仍在执行，线程池可继续使用
+    const int finished_after_join = finished.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK(finished.load() == finished_after_join);
+    require_all_once(pool, 1000);
+}
+
+TEST_CASE("线程池：调用线程与常驻线程上的任务都抛出异常时只重新抛出第一个，异常不丢失", "[WorkerPool]")
+{
+    WorkerPool pool(4);
+    for (int round = 0; round < 50; ++round)
+    {
+        std::atomic<int> started{0};
+        bool caught = false;
+        try
+        {
+            pool.run(64, [&](std::uint32_t i)
+                     {
+                         started.fetch_add(1);
+                         throw std::out_of_range(std::to_string(i)); });
+        }
+        catch (const std::out_of_range &)
+        {
+            caught = true;
+        }
+        REQUIRE(caught);
+        // 抛出后其余任务不再领取：每个线程最多执行一个任务
+        CHECK(started.load() <= static_cast<int>(pool.size()));
+    }
+    require_all_once(pool, 64);
+
+    // 串行路径（单线程或单任务）异常直接传出
+    WorkerPool serial(1);
+    CHECK_THROWS_AS(serial.run(3, [](std::uint32_t i)
+                               { if (i == 1) throw std::logic_error("serial"); }),
+                    std::logic_error);
+    CHECK_THROWS_AS(pool.run(1, [](std::uint32_t)
+                             { throw std::logic_error("single"); }),
+                    std::logic_error);
+    require_all_once(serial, 3);
+}